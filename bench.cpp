@@ -0,0 +1,296 @@
+#include "simulador.h"
+using namespace std;
+
+// Microbenchmarks de los caminos calientes del simulador.
+//   bench [--rapido] [--filtro <texto>] [--salida <archivo.json>]
+//   bench --comparar <base.json> <nuevo.json>
+// Los resultados salen en JSON (un resultado por linea) para comparar dos builds;
+// el resumen legible va a stderr.
+
+
+struct Resultado {
+    string nombre;
+    long long parametro;   // profundidad de cola, cantidad de solicitudes...
+    long long operaciones;
+    double ms_total;
+    double ns_por_op() const { return operaciones ? ms_total * 1e6 / operaciones : 0.0; }
+};
+
+struct Opciones {
+    bool rapido = false;
+    string filtro;
+    string salida;
+};
+
+using reloj = chrono::steady_clock;
+
+double ms_desde(reloj::time_point t0) {
+    return chrono::duration<double, milli>(reloj::now() - t0).count();
+}
+
+
+class SuiteBench {
+private:
+    Opciones op;
+    vector<Resultado> resultados;
+
+    bool seleccionado(const string &nombre) const {
+        return op.filtro.empty() || nombre.find(op.filtro) != string::npos;
+    }
+
+    void registrar(const string &nombre, long long parametro, long long operaciones, double ms) {
+        resultados.push_back({nombre, parametro, operaciones, ms});
+        cerr << left << setw(44) << nombre << right << setw(10) << parametro << setw(12) << operaciones
+             << fixed << setprecision(1) << setw(14) << resultados.back().ns_por_op() << " ns/op\n";
+    }
+
+    // ----- Memoria -----
+    // hit: marcos/2 paginas (todo acierto tras calentar); miss: 64 paginas por marco al azar.
+    void bench_memoria() {
+        const char *politicas[] = {"fifo", "lru", "ws", "clock", "sc", "aging"};
+        int accesos = op.rapido ? 20000 : 200000;
+        vector<int> tamanos = op.rapido ? vector<int>{64, 4096} : vector<int>{64, 65536};
+        for (int marcos : tamanos) {
+            for (auto pol : politicas) {
+                for (bool hits : {true, false}) {
+                    string nombre = string("GestorMarcos::acceder_pagina/") + pol + (hits ? "/hit" : "/miss");
+                    if (!seleccionado(nombre)) continue;
+                    PoliticaMemoria politica;
+                    politica_desde_texto(pol, politica);
+                    GestorMarcos gestor(marcos, politica, 5);
+                    mt19937 rng(7);
+                    int paginas = hits ? marcos / 2 : marcos * 64;
+                    vector<int> refs(accesos);
+                    for (auto &r : refs) r = (int)(rng() % paginas);
+                    bool hit;
+                    for (int p = 0; p < paginas && hits; ++p) gestor.acceder_pagina(1, p, hit);
+                    // los fallos se miden con la memoria ya llena
+                    for (int p = 0; p < marcos && !hits; ++p) gestor.acceder_pagina(2, p, hit);
+                    auto t0 = reloj::now();
+                    for (int r : refs) gestor.acceder_pagina(1, r, hit);
+                    registrar(nombre, marcos, accesos, ms_desde(t0));
+                }
+            }
+            // LRU con un TLB de 64 entradas y 4 vias: el acierto evita la tabla de paginas
+            for (bool hits : {true, false}) {
+                string nombre = string("GestorMarcos::acceder_pagina/lru+tlb") + (hits ? "/hit" : "/miss");
+                if (!seleccionado(nombre)) continue;
+                GestorMarcos gestor(marcos, PoliticaMemoria::LRU, 5);
+                gestor.set_tlb(ConfigTLB{64, 4, ReemplazoTLB::LRU, true});
+                mt19937 rng(7);
+                int paginas = hits ? 32 : marcos * 64;
+                vector<int> refs(accesos);
+                for (auto &r : refs) r = (int)(rng() % paginas);
+                bool hit;
+                for (int p = 0; p < paginas && hits; ++p) gestor.acceder_pagina(1, p, hit);
+                for (int p = 0; p < marcos && !hits; ++p) gestor.acceder_pagina(2, p, hit);
+                auto t0 = reloj::now();
+                for (int r : refs) gestor.acceder_pagina(1, r, hit);
+                registrar(nombre, marcos, accesos, ms_desde(t0));
+            }
+        }
+    }
+
+    // ----- Planificadores -----
+    // 'profundidad' procesos que no terminan durante la medicion: cada tick es un paso del motor.
+    void bench_planificadores() {
+        vector<int> profundidades = op.rapido ? vector<int>{1, 100, 10000} : vector<int>{1, 100, 10000, 1000000};
+        int ticks = op.rapido ? 20000 : 200000;
+        GestorMarcos gestor;
+        for (int prof : profundidades) {
+            if (seleccionado("PlanificadorRR::tick")) {
+                PlanificadorRR rr(2);
+                for (int i = 0; i < prof; ++i) rr.crear_proceso(1 << 30);
+                auto t0 = reloj::now();
+                for (int t = 0; t < ticks; ++t) rr.tick(gestor);
+                registrar("PlanificadorRR::tick", prof, ticks, ms_desde(t0));
+            }
+            if (seleccionado("PlanificadorSJF::tick")) {
+                PlanificadorSJF sjf;
+                mt19937 rng(prof);
+                for (int i = 0; i < prof; ++i) sjf.crear_proceso((1 << 29) + (int)(rng() % 1000000));
+                auto t0 = reloj::now();
+                for (int t = 0; t < ticks; ++t) sjf.tick(gestor);
+                registrar("PlanificadorSJF::tick", prof, ticks, ms_desde(t0));
+            }
+            // arbol de vruntime: cada fin de rebanada reinserta al proceso y toma el de menor vruntime
+            if (seleccionado("PlanificadorCFS::tick")) {
+                PlanificadorCFS cfs;
+                for (int i = 0; i < prof; ++i) cfs.crear_proceso(1 << 30);
+                auto t0 = reloj::now();
+                for (int t = 0; t < ticks; ++t) cfs.tick(gestor);
+                registrar("PlanificadorCFS::tick", prof, ticks, ms_desde(t0));
+            }
+            // una llegada por tick: insercion en el heap y posible preempcion SRTF
+            if (seleccionado("PlanificadorSJF::tick+llegada")) {
+                PlanificadorSJF sjf;
+                mt19937 rng(prof);
+                for (int i = 0; i < prof; ++i) sjf.crear_proceso((1 << 29) + (int)(rng() % 1000000));
+                auto t0 = reloj::now();
+                for (int t = 0; t < ticks; ++t) {
+                    sjf.crear_proceso((1 << 29) + (int)(rng() % 1000000));
+                    sjf.tick(gestor);
+                }
+                registrar("PlanificadorSJF::tick+llegada", prof, ticks, ms_desde(t0));
+            }
+        }
+    }
+
+    // ----- Disco -----
+    void bench_disco() {
+        long long max_n = op.rapido ? 100000 : 10000000;
+        for (long long n = 1000; n <= max_n; n *= 10) {
+            mt19937 rng((unsigned)n);
+            const int CILINDROS = 1000000;
+            vector<int> reqs(n);
+            for (auto &r : reqs) r = (int)(rng() % CILINDROS);
+            if (seleccionado("SimuladorDisco::SSTF")) {
+                auto t0 = reloj::now();
+                auto rec = SimuladorDisco::recorrido_SSTF(reqs, CILINDROS / 2);
+                registrar("SimuladorDisco::SSTF", n, n, ms_desde(t0));
+            }
+            if (seleccionado("SimuladorDisco::SCAN")) {
+                auto t0 = reloj::now();
+                auto rec = SimuladorDisco::recorrido_SCAN(reqs, CILINDROS / 2, true, CILINDROS - 1);
+                registrar("SimuladorDisco::SCAN", n, n, ms_desde(t0));
+            }
+        }
+    }
+
+    // ----- Dispositivos -----
+    // 'profundidad' solicitudes encoladas (1..5 ticks cada una) en 1 dispositivo o repartidas en
+    // 10000; se miden ticks del gestor (solo tocan los dispositivos que terminan en ese tick).
+    void bench_dispositivos() {
+        vector<int> profundidades = op.rapido ? vector<int>{10, 10000} : vector<int>{10, 10000, 1000000};
+        int ticks = op.rapido ? 20000 : 200000;
+        for (int n_disp : {1, 10000}) {
+            string nombre = "GestorDispositivos::tick/" + to_string(n_disp) + "disp";
+            if (!seleccionado(nombre)) continue;
+            for (int prof : profundidades) {
+                TablaProcesos tabla;
+                tabla.reservar(prof);
+                GestorDispositivos gestor_io(nullptr);
+                vector<int> handles;
+                for (int d = 0; d < n_disp; ++d) handles.push_back(gestor_io.agregar("d" + to_string(d), TipoDispositivo::DISCO));
+                mt19937 rng(prof);
+                for (int i = 0; i < prof; ++i) {
+                    int pid = tabla.crear(1, 0);
+                    gestor_io.solicitar(handles[i % n_disp], {&tabla, pid}, 1 + (int)(rng() % 5), (int)(rng() % 4));
+                }
+                auto t0 = reloj::now();
+                gestor_io.avanzar(ticks);
+                registrar(nombre, prof, ticks, ms_desde(t0));
+            }
+        }
+    }
+
+    // ----- Productor-Consumidor con hilos -----
+    // parametro = hilos por lado; ns/op del item de punta a punta con el buffer de 1024 celdas
+    void bench_productor_consumidor() {
+        long long items = op.rapido ? 200000 : 2000000;
+        for (int hilos : {1, 2, 4}) {
+            for (auto tipo : {TipoBufferPC::SPSC, TipoBufferPC::MPMC, TipoBufferPC::MUTEX}) {
+                string nombre = string("ProductorConsumidor/") + nombre_buffer_pc(tipo);
+                if (!seleccionado(nombre)) continue;
+                ParametrosPC par;
+                par.tipo = tipo;
+                par.productores = par.consumidores = hilos;
+                par.items = items;
+                ResultadoPC r = ejecutar_productor_consumidor(par);
+                registrar(nombre, hilos, items, r.segundos * 1000);
+            }
+        }
+    }
+
+public:
+    explicit SuiteBench(Opciones o) : op(std::move(o)) {}
+
+    void ejecutar() {
+        cerr << left << setw(44) << "benchmark" << right << setw(10) << "param" << setw(12) << "ops"
+             << setw(20) << "tiempo\n";
+        bench_memoria();
+        bench_planificadores();
+        bench_disco();
+        bench_dispositivos();
+        bench_productor_consumidor();
+    }
+
+    void escribir_json(ostream &os) const {
+        os << "{\n  \"suite\": \"simulador\",\n";
+#ifdef SIM_BUILD_TIPO
+        os << "  \"build\": \"" << SIM_BUILD_TIPO << "\",\n";
+#endif
+        os << "  \"compilador\": \"" << __VERSION__ << "\",\n";
+        os << "  \"rapido\": " << (op.rapido ? "true" : "false") << ",\n";
+        os << "  \"resultados\": [\n";
+        for (size_t i = 0; i < resultados.size(); ++i) {
+            const auto &r = resultados[i];
+            os << "    {\"nombre\": \"" << r.nombre << "\", \"parametro\": " << r.parametro
+               << ", \"operaciones\": " << r.operaciones << fixed << setprecision(3)
+               << ", \"ms_total\": " << r.ms_total << ", \"ns_por_op\": " << r.ns_por_op() << "}"
+               << (i + 1 < resultados.size() ? "," : "") << "\n";
+        }
+        os << "  ]\n}\n";
+    }
+};
+
+
+// Lee los resultados de un JSON escrito por escribir_json (un resultado por linea)
+map<pair<string, long long>, double> leer_resultados(const string &ruta) {
+    map<pair<string, long long>, double> res;
+    ifstream in(ruta);
+    string linea;
+    while (getline(in, linea)) {
+        size_t n = linea.find("\"nombre\": \"");
+        if (n == string::npos) continue;
+        size_t ini = n + 11, fin = linea.find('"', ini);
+        string nombre = linea.substr(ini, fin - ini);
+        long long parametro = stoll(linea.substr(linea.find("\"parametro\": ") + 13));
+        double ns = stod(linea.substr(linea.find("\"ns_por_op\": ") + 13));
+        res[{nombre, parametro}] = ns;
+    }
+    return res;
+}
+
+int comparar(const string &base, const string &nuevo) {
+    auto a = leer_resultados(base), b = leer_resultados(nuevo);
+    if (a.empty() || b.empty()) { cerr << "[!] No se pudieron leer los resultados\n"; return 1; }
+    cout << left << setw(44) << "benchmark" << right << setw(10) << "param" << setw(14) << "base ns/op"
+         << setw(14) << "nuevo ns/op" << setw(10) << "x" << "\n";
+    for (auto &[clave, ns_base] : a) {
+        auto it = b.find(clave);
+        if (it == b.end()) continue;
+        cout << left << setw(44) << clave.first << right << setw(10) << clave.second << fixed << setprecision(1)
+             << setw(14) << ns_base << setw(14) << it->second << setprecision(2)
+             << setw(10) << (it->second > 0 ? ns_base / it->second : 0.0) << "\n";
+    }
+    return 0;
+}
+
+
+int main(int argc, char **argv) {
+    Opciones op;
+    for (int i = 1; i < argc; ++i) {
+        string a = argv[i];
+        if (a == "--rapido") op.rapido = true;
+        else if (a == "--filtro" && i + 1 < argc) op.filtro = argv[++i];
+        else if (a == "--salida" && i + 1 < argc) op.salida = argv[++i];
+        else if (a == "--comparar" && i + 2 < argc) return comparar(argv[i + 1], argv[i + 2]);
+        else {
+            cerr << "Uso: bench [--rapido] [--filtro <texto>] [--salida <archivo.json>]\n"
+                 << "       bench --comparar <base.json> <nuevo.json>\n";
+            return 1;
+        }
+    }
+
+    SuiteBench suite(op);
+    suite.ejecutar();
+    if (op.salida.empty()) {
+        suite.escribir_json(cout);
+    } else {
+        ofstream out(op.salida);
+        suite.escribir_json(out);
+        cerr << "[BENCH] Resultados en " << op.salida << "\n";
+    }
+    return 0;
+}
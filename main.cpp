@@ -1,1026 +1,125 @@
-#include <iostream>
-#include <queue>
-#include <vector>
-#include <string>
-#include <map>
-#include <memory>
-#include <algorithm>
-#include <mutex>
-#include <condition_variable>
-#include <thread>
-#include <sstream>
-#include <deque>
-#include <optional>
-#include <iomanip>
+#include "simulador.h"
 using namespace std;
 
 
-void procesar_comando(const string &comando);
-
-
-struct Proceso {
-    int id_proceso;
-    int tiempo_requerido;
-    int tiempo_restante;
-    int tiempo_llegada;
-    int tiempo_inicio;
-    int tiempo_finalizacion;
-    string estado; // "LISTO", "EJECUTANDO", "TERMINADO", "BLOQUEADO"
-    int tiempo_espera_acumulado;
-    int response_time; // tiempo hasta primer start
-    int quantum_consumido;
-    int quantums_served;
-
-    Proceso(int id, int tiempo, int llegada) :
-        id_proceso(id),
-        tiempo_requerido(tiempo),
-        tiempo_restante(tiempo),
-        tiempo_llegada(llegada),
-        tiempo_inicio(-1),
-        tiempo_finalizacion(-1),
-        estado("LISTO"),
-        tiempo_espera_acumulado(0),
-        response_time(-1),
-        quantum_consumido(0),
-        quantums_served(0) {}
-};
-
-
-// ------------------------- FrameManager + Tablas de páginas -------------------------
-struct Frame {
-    int pid = -1;
-    int pagina = -1;
-    int last_used = 0; // para LRU
-};
-
-
-struct AccesoRegistro {
-    int tick;
-    int pid;
-    int pagina;
-    bool hit;
-    int tiempo_acceso_simulado; // ticks consumidos por el acceso
-};
-
-
-// ------------------------ Gestor de Marcos (Working Set) ---------------------------- //
-class GestorMarcos {
-private:
-    vector<Frame> marcos;
-    deque<int> cola_fifo;
-    int max_marcos;
-    int reloj_tick;
-    int accesos_totales;
-    int fallos_totales;
-    vector<AccesoRegistro> trazas;
-
-    // NUEVOS CAMPOS
-    bool usar_lru;
-    bool usar_ws;
-    int ventana_ws; // tamaño de la ventana Working Set
-
-public:
-    map<int, map<int,int>> tabla_paginas;
-
-    GestorMarcos(int n_marcos = 3, bool lru = false, bool ws = false, int ventana = 5)
-        : max_marcos(n_marcos), reloj_tick(0), accesos_totales(0),
-          fallos_totales(0), usar_lru(lru), usar_ws(ws), ventana_ws(ventana) {
-        marcos.resize(max_marcos);
-        for (int i = 0; i < max_marcos; ++i) cola_fifo.push_back(i);
-    }
-
-    int acceder_pagina(int pid, int pagina, bool lru_flag, bool &hit) {
-        reloj_tick++;
-        accesos_totales++;
-
-        usar_lru = lru_flag; // actualiza modo activo dinámicamente
-
-        // HIT
-        if (tabla_paginas.count(pid) && tabla_paginas[pid].count(pagina)) {
-            int marco = tabla_paginas[pid][pagina];
-            if (marcos[marco].pid == pid && marcos[marco].pagina == pagina) {
-                hit = true;
-                marcos[marco].last_used = reloj_tick;
-                trazas.push_back({reloj_tick, pid, pagina, true, 1});
-                return 1;
-            }
-        }
-
-        // MISS
-        hit = false;
-        fallos_totales++;
-        int tiempo_miss = 10;
-
-        int marco_libre = -1;
-        for (int i = 0; i < max_marcos; ++i) {
-            if (marcos[i].pid == -1) { marco_libre = i; break; }
-        }
-
-        int elegido = -1;
-        if (marco_libre != -1) {
-            elegido = marco_libre;
-        } else if (usar_ws) {
-            // WORKING SET: reemplaza página fuera del conjunto activo
-            int candidato = -1;
-            int oldest_time = INT_MAX;
-            for (int i = 0; i < max_marcos; ++i) {
-                int edad = reloj_tick - marcos[i].last_used;
-                if (edad > ventana_ws) { // fuera del conjunto de trabajo
-                    candidato = i;
-                    break;
-                }
-                if (marcos[i].last_used < oldest_time) {
-                    oldest_time = marcos[i].last_used;
-                    elegido = i; // fallback: la más vieja si todas activas
-                }
-            }
-            if (candidato != -1) elegido = candidato;
-        } else if (usar_lru) {
-            // LRU clásico
-            int min_used = INT_MAX;
-            for (int i = 0; i < max_marcos; ++i) {
-                if (marcos[i].last_used < min_used) {
-                    min_used = marcos[i].last_used;
-                    elegido = i;
-                }
-            }
-        } else {
-            // FIFO
-            elegido = cola_fifo.front();
-            cola_fifo.pop_front();
-            cola_fifo.push_back(elegido);
-        }
-
-        // limpiar entrada anterior
-        int pid_victima = marcos[elegido].pid;
-        int pag_victima = marcos[elegido].pagina;
-        if (pid_victima != -1)
-            tabla_paginas[pid_victima].erase(pag_victima);
-
-        // asignar
-        marcos[elegido].pid = pid;
-        marcos[elegido].pagina = pagina;
-        marcos[elegido].last_used = reloj_tick;
-        tabla_paginas[pid][pagina] = elegido;
-
-        trazas.push_back({reloj_tick, pid, pagina, false, tiempo_miss});
-        return tiempo_miss;
-    }
-
-    void set_politica(bool lru, bool ws, int ventana = 5) {
-        usar_lru = lru;
-        usar_ws = ws;
-        ventana_ws = ventana;
-    }
-
-    // Resto de metodos igual...
-    void mostrar_estado() const {
-        cout << "\n[Memoria] Estado de marcos (index: PID->Pagina, last_used)\n";
-        for (int i = 0; i < max_marcos; ++i) {
-            cout << " Marco[" << setw(2) << i << "]: ";
-            if (marcos[i].pid == -1) cout << "(libre)\n";
-            else cout << "PID " << marcos[i].pid << " -> Pag " << marcos[i].pagina
-                      << " (last=" << marcos[i].last_used << ")\n";
-        }
-        cout << "Accesos totales: " << accesos_totales
-             << " | Fallos totales: " << fallos_totales
-             << " | Tasa fallos: "
-             << (accesos_totales>0 ? (double)fallos_totales/accesos_totales : 0.0)
-             << "\n";
-    }
-
-    void mostrar_trazas(int ultimos = 20) const {
-        cout << "\n[Memoria] Ultimas trazas de acceso (tick pid pag HIT tiempo):\n";
-        int inicio = max(0, (int)trazas.size() - ultimos);
-        for (int i = inicio; i < (int)trazas.size(); ++i) {
-            const auto &r = trazas[i];
-            cout << " " << r.tick << " | PID " << r.pid << " | Pag " << r.pagina
-                 << " | " << (r.hit ? "HIT " : "MISS")
-                 << " | t=" << r.tiempo_acceso_simulado << "\n";
-        }
-    }
-
-        // Libera todos los marcos usados por un proceso terminado
-    void liberar_proceso(int pid) {
-        for (int i = 0; i < max_marcos; ++i) {
-            if (marcos[i].pid == pid) {
-                marcos[i] = Frame(); // marco libre
-            }
-        }
-        tabla_paginas.erase(pid);
-    }
-
-    void visualizar_memoria_ascii() const {
-        cout << "\n[Visualizacion ASCII - Marcos de Memoria]\n";
-        if (marcos.empty()) {
-            cout << "(Sin marcos)\n";
-            return;
-        }
-
-        const string verde = "\033[1;32m"; // verde para hit
-        const string rojo = "\033[1;31m";  // rojo para miss
-        const string gris = "\033[1;90m";  // gris para libre
-        const string reset = "\033[0m";
-
-        // determinar los ultimos accesos para marcar colores
-        map<int, bool> ultimo_hit_por_marco;
-        if (!trazas.empty()) {
-            auto r = trazas.back();
-            // busca el marco donde cayo el acceso
-            for (int i = 0; i < max_marcos; ++i) {
-                if (marcos[i].pid == r.pid && marcos[i].pagina == r.pagina) {
-                    ultimo_hit_por_marco[i] = r.hit;
-                }
-            }
-        }
-
-        cout << "+--------------------------------------------------+\n";
-        for (int i = 0; i < max_marcos; ++i) {
-            string color = gris;
-            string contenido = "(libre)";
-            if (marcos[i].pid != -1) {
-                contenido = "PID " + to_string(marcos[i].pid) +
-                            " P" + to_string(marcos[i].pagina);
-                if (ultimo_hit_por_marco.count(i))
-                    color = (ultimo_hit_por_marco.at(i) ? verde : rojo);
-            }
-            cout << "| Marco[" << setw(2) << i << "]: "
-                 << color << setw(15) << left << contenido << reset
-                 << " (last=" << setw(3) << marcos[i].last_used << ") |\n";
-        }
-        cout << "+--------------------------------------------------+\n";
-        cout << "HIT = verde | MISS = rojo | Libre = gris\n";
-    }
-
-};
-
-
-// ------------------------- Planificador Round Robin -------------------------
-class PlanificadorRR {
-private:
-    queue<shared_ptr<Proceso>> cola_listos;
-    map<int, shared_ptr<Proceso>> procesos;
-    int tiempo_quantum;
-    int tiempo_actual;
-    int sig_id_proceso;
-    shared_ptr<Proceso> proceso_en_cpu; // proceso actualmente en CPU (o nullptr)
-public:
-    PlanificadorRR(int quantum=2) : tiempo_quantum(quantum), tiempo_actual(0), sig_id_proceso(1), proceso_en_cpu(nullptr) {}
-
-    int crear_proceso(int tiempo_requerido, int llegada_offset = 0) {
-        int llegada = tiempo_actual + llegada_offset;
-        auto p = make_shared<Proceso>(sig_id_proceso++, tiempo_requerido, llegada);
-        // Si llegada == tiempo_actual lo ponemos en cola de listos, si no, queda registrado y se insertará cuando llegue
-        procesos[p->id_proceso] = p;
-        if (llegada <= tiempo_actual) {
-            cola_listos.push(p);
-            cout << "[+] Proceso creado (RR) | id=" << p->id_proceso << " tiempo=" << tiempo_requerido << " (LISTO)\n";
-        } else {
-            p->estado = "LISTO"; // seguirá en estado LISTO pero no en cola hasta que llegue
-            cout << "[+] Proceso creado con llegada futura | id=" << p->id_proceso << " tiempo=" << tiempo_requerido
-                 << " llegada=" << p->tiempo_llegada << "\n";
-        }
-        return p->id_proceso;
-    }
-
-    // Exponer enqueue para semaforo signal
-    void enqueue_ready(shared_ptr<Proceso> p) {
-        if (p->estado != "TERMINADO") {
-            p->estado = "LISTO";
-            cola_listos.push(p);
-        }
-    }
-
-    // actualiza colas con procesos cuya llegada ha ocurrido
-    void incorporar_llegadas() {
-        for (auto &kv : procesos) {
-            auto p = kv.second;
-            if (p->tiempo_llegada <= tiempo_actual && p->estado == "LISTO") {
-                // si no está en cola debemos añadir; para evitar duplicados no comprobamos presencia en cola (simple)
-                // Se puede mejorar con un flag 'en_cola'
-                bool esta = false;
-                // simple: si proceso_en_cpu es el mismo, no push
-                if (proceso_en_cpu && proceso_en_cpu->id_proceso == p->id_proceso) esta = true;
-                if (!esta) {
-                    // Evitar añadir si ya finalizado
-                    if (p->estado != "TERMINADO" && p->tiempo_restante > 0) {
-                        cola_listos.push(p);
-                    }
-                }
-            }
-        }
-    }
-
-    // Ejecutar un tick (1 unidad de tiempo). Gestiona seleccion, preempcion y metricas.
-    void tick(GestorMarcos &gestor, bool mem_lru_flag) {
-        // incorporar llegadas antes de seleccionar
-        incorporar_llegadas();
-
-        // Si no hay proceso en CPU, seleccionar uno
-        if (!proceso_en_cpu) {
-            // eliminar procesos terminados del frente
-            while (!cola_listos.empty() && cola_listos.front()->estado == "TERMINADO") cola_listos.pop();
-            if (!cola_listos.empty()) {
-                proceso_en_cpu = cola_listos.front();
-                cola_listos.pop();
-                if (proceso_en_cpu->tiempo_inicio == -1) proceso_en_cpu->tiempo_inicio = tiempo_actual;
-                proceso_en_cpu->estado = "EJECUTANDO";
-                proceso_en_cpu->quantum_consumido = 0;
-                if (proceso_en_cpu->response_time == -1) {
-                    proceso_en_cpu->response_time = tiempo_actual - proceso_en_cpu->tiempo_llegada;
-                }
-                proceso_en_cpu->quantums_served++;
-                cout << "[TICK " << tiempo_actual << "] Context switch -> PID " << proceso_en_cpu->id_proceso << "\n";
-            } else {
-                cout << "[TICK " << tiempo_actual << "] CPU IDLE\n";
-                tiempo_actual++;
-                return;
-            }
-        }
-
-        // Ejecutar 1 unidad del proceso en CPU
-        tiempo_actual++;
-        proceso_en_cpu->tiempo_restante -= 1;
-        proceso_en_cpu->quantum_consumido += 1;
-
-        // incrementar espera de los procesos listos
-        for (auto &kv : procesos) {
-            auto p = kv.second;
-            if (p->estado == "LISTO") p->tiempo_espera_acumulado++;
-        }
-
-        cout << "[TICK " << tiempo_actual << "] Ejecutando PID " << proceso_en_cpu->id_proceso
-             << " (restante=" << proceso_en_cpu->tiempo_restante << ", quantum_usado=" << proceso_en_cpu->quantum_consumido << ")\n";
-
-        // comprobacion: si proceso termina
-        if (proceso_en_cpu->tiempo_restante <= 0) {
-            proceso_en_cpu->estado = "TERMINADO";
-            proceso_en_cpu->tiempo_finalizacion = tiempo_actual;
-            cout << "[EVENT] PID " << proceso_en_cpu->id_proceso << " TERMINADO en tick " << tiempo_actual << "\n";
-            // liberar marcos asociados
-            gestor.liberar_proceso(proceso_en_cpu->id_proceso);
-            proceso_en_cpu = nullptr;
-            return;
-        }
-
-        // si quantum consumido alcanza el quantum => preemption
-        if (proceso_en_cpu->quantum_consumido >= tiempo_quantum) {
-            proceso_en_cpu->estado = "LISTO";
-            cola_listos.push(proceso_en_cpu);
-            cout << "[EVENT] Preempcion -> PID " << proceso_en_cpu->id_proceso << " vuelve a cola LISTOS\n";
-            proceso_en_cpu = nullptr;
-            return;
-        }
-    }
-
-    // Ejecutar N ticks secuenciales (usa tick())
-    void ejecutar_ticks(int n, GestorMarcos &gestor, bool mem_lru_flag) {
-        for (int i = 0; i < n; ++i) tick(gestor, mem_lru_flag);
-    }
-
-    void listar_procesos() {
-        cout << "\nID\tEstado\tRest\tInicio\tFin\tEspera\tResp\tQuantServed\n";
-        for (auto &kv : procesos) {
-            auto p = kv.second;
-            cout << p->id_proceso << "\t" << p->estado << "\t" << p->tiempo_restante << "\t"
-                 << p->tiempo_inicio << "\t" << p->tiempo_finalizacion << "\t"
-                 << p->tiempo_espera_acumulado << "\t" << p->response_time << "\t" << p->quantums_served << "\n";
-        }
-    }
-
-    void estadisticas_generales() {
-        double espera_total = 0;
-        double retorno_total = 0;
-        int finalizados = 0;
-        int n = procesos.size();
-        int cpu_ticks_ocupados = 0;
-        int makespan = tiempo_actual;
-        for (auto &kv : procesos) {
-            auto p = kv.second;
-            if (p->tiempo_finalizacion != -1) {
-                int turnaround = p->tiempo_finalizacion - p->tiempo_llegada;
-                int waiting = turnaround - p->tiempo_requerido;
-                espera_total += waiting;
-                retorno_total += turnaround;
-                finalizados++;
-            }
-            cpu_ticks_ocupados += (p->tiempo_requerido - p->tiempo_restante);
-        }
-        cout << fixed << setprecision(3);
-        if (finalizados == 0) cout << "Aun no hay procesos finalizados.\n";
-        else {
-            cout << "Promedio espera: " << (espera_total / finalizados)
-                 << " | Promedio turnaround: " << (retorno_total / finalizados) << "\n";
-        }
-        double utilizacion = (makespan>0 ? (double)cpu_ticks_ocupados / makespan : 0.0);
-        cout << "Tiempo actual (makespan sim): " << tiempo_actual << " | CPU utilisation (sim): " << utilizacion << "\n";
-    }
-
-    shared_ptr<Proceso> obtener_proceso(int id) {
-        return procesos.count(id) ? procesos[id] : nullptr;
-    }
-
-    void terminar_proceso(int id) {
-        if (!procesos.count(id)) {
-            cout << "[!] No existe proceso " << id << "\n";
-            return;
-        }
-        auto p = procesos[id];
-        p->estado = "TERMINADO";
-        p->tiempo_finalizacion = tiempo_actual;
-        cout << "[X] Proceso " << id << " terminado manualmente.\n";
-    }
-};
-
-
-// ------------------------- Planificador SJF -------------------------
-class PlanificadorSJF {
-private:
-    vector<shared_ptr<Proceso>> cola_listos;
-    map<int, shared_ptr<Proceso>> procesos;
-    int tiempo_actual;
-    int sig_id_proceso;
-    shared_ptr<Proceso> proceso_en_cpu;
-
-public:
-    PlanificadorSJF() : tiempo_actual(0), sig_id_proceso(1), proceso_en_cpu(nullptr) {}
-
-    int crear_proceso(int tiempo_requerido, int llegada_offset = 0) {
-        int llegada = tiempo_actual + llegada_offset;
-        auto p = make_shared<Proceso>(sig_id_proceso++, tiempo_requerido, llegada);
-        procesos[p->id_proceso] = p;
-        cola_listos.push_back(p);
-        cout << "[+] Proceso creado (SJF) | id=" << p->id_proceso << " tiempo=" << tiempo_requerido << "\n";
-        return p->id_proceso;
-    }
-
-    void tick(GestorMarcos &gestor, bool mem_lru_flag) {
-        // eliminar terminados de la lista
-        cola_listos.erase(remove_if(cola_listos.begin(), cola_listos.end(),
-            [](auto &p){ return p->estado == "TERMINADO"; }), cola_listos.end());
-
-        if (!proceso_en_cpu) {
-            if (cola_listos.empty()) {
-                cout << "[TICK " << tiempo_actual << "] CPU IDLE\n";
-                tiempo_actual++;
-                return;
-            }
-
-            // seleccionar el proceso con menor tiempo restante
-            sort(cola_listos.begin(), cola_listos.end(),
-                 [](auto &a, auto &b){ return a->tiempo_restante < b->tiempo_restante; });
-
-            proceso_en_cpu = cola_listos.front();
-            cola_listos.erase(cola_listos.begin());
-
-            if (proceso_en_cpu->tiempo_inicio == -1)
-                proceso_en_cpu->tiempo_inicio = tiempo_actual;
-
-            proceso_en_cpu->estado = "EJECUTANDO";
-            cout << "[TICK " << tiempo_actual << "] SJF selecciona PID " << proceso_en_cpu->id_proceso << "\n";
-        }
-
-        // ejecutar 1 tick
-        tiempo_actual++;
-        proceso_en_cpu->tiempo_restante -= 1;
-
-        for (auto &kv : procesos) {
-            auto p = kv.second;
-            if (p->estado == "LISTO") p->tiempo_espera_acumulado++;
-        }
-
-        cout << "[TICK " << tiempo_actual << "] Ejecutando PID " << proceso_en_cpu->id_proceso
-             << " (restante=" << proceso_en_cpu->tiempo_restante << ")\n";
-
-        if (proceso_en_cpu->tiempo_restante <= 0) {
-            proceso_en_cpu->estado = "TERMINADO";
-            proceso_en_cpu->tiempo_finalizacion = tiempo_actual;
-            cout << "[EVENT] PID " << proceso_en_cpu->id_proceso << " TERMINADO en tick " << tiempo_actual << "\n";
-            gestor.liberar_proceso(proceso_en_cpu->id_proceso);
-            proceso_en_cpu = nullptr;
-        }
-    }
-
-    void ejecutar_ticks(int n, GestorMarcos &gestor, bool mem_lru_flag) {
-        for (int i = 0; i < n; ++i) tick(gestor, mem_lru_flag);
-    }
-
-    shared_ptr<Proceso> obtener_proceso(int id) {
-        auto it = procesos.find(id);
-        if (it != procesos.end())
-            return it->second;
-        return nullptr;
-    }
-
-    void listar_procesos() {
-        cout << "\nID\tEstado\tRest\tInicio\tFin\tEspera\n";
-        for (auto &kv : procesos) {
-            auto p = kv.second;
-            cout << p->id_proceso << "\t" << p->estado << "\t" << p->tiempo_restante
-                 << "\t" << p->tiempo_inicio << "\t" << p->tiempo_finalizacion
-                 << "\t" << p->tiempo_espera_acumulado << "\n";
-        }
-    }
-};
-
-
-// ------------------------- Semáforo simulado -------------------------
-class SemaforoSimulado {
-private:
-    int valor;
-    queue<shared_ptr<Proceso>> cola_bloqueados;
-public:
-    SemaforoSimulado(int v = 1): valor(v) {}
-    // Wait: si valor>0 decrementa, si no, bloquea al proceso (cambia su estado)
-    void wait(shared_ptr<Proceso> p) {
-        if (valor > 0) {
-            valor--;
-        } else {
-            p->estado = "BLOQUEADO";
-            cola_bloqueados.push(p);
-        }
-    }
-    // Signal: si hay bloqueados, despierta al primero; si no, incrementa valor
-    shared_ptr<Proceso> signal() {
-        if (!cola_bloqueados.empty()) {
-            auto p = cola_bloqueados.front();
-            cola_bloqueados.pop();
-            p->estado = "LISTO";
-            return p;
-        } else {
-            valor++;
-            return nullptr;
-        }
-    }
-    int get_valor() const { return valor; }
-    size_t bloqueados() const { return cola_bloqueados.size(); }
-};
-
-
-// ------------------------- Productor-Consumidor simulado -------------------------
-class ProductorConsumidorSimulado {
-private:
-    deque<int> buffer;
-    size_t capacidad;
-    SemaforoSimulado sem_vacio; // cuenta de vacios (capacidad)
-    SemaforoSimulado sem_item;  // cuenta de items disponibles
-public:
-    ProductorConsumidorSimulado(size_t cap=5)
-        : capacidad(cap), sem_vacio((int)cap), sem_item(0) {}
-
-    // Produce de forma simulada: si buffer lleno => bloquea (retornamos false)
-    bool producir_simulado(int item) {
-        // si hay hueco inmediato
-        if (buffer.size() < capacidad) {
-            buffer.push_back(item);
-            // signal item
-            sem_item.signal();
-            // consume un espacio de vacio (decrement) ya fue consumido por push
-            // en el modelo simulado no usamos valor interno de sem_vacio aqui
-            cout << "[SYNC] Producido " << item << " (buffer=" << buffer.size() << ")\n";
-            return true;
-        } else {
-            cout << "[SYNC] Buffer lleno: produccion bloqueada (simulado) \n";
-            return false;
-        }
-    }
-
-    // Consume de forma simulada: si buffer vacio => bloquea (retornamos false)
-    bool consumir_simulado() {
-        if (!buffer.empty()) {
-            int item = buffer.front();
-            buffer.pop_front();
-            sem_vacio.signal();
-            cout << "[SYNC] Consumido " << item << " (restan=" << buffer.size() << ")\n";
-            return true;
-        } else {
-            cout << "[SYNC] Buffer vacio: consumo bloqueado (simulado)\n";
-            return false;
-        }
-    }
-
-    void estado_buffer() const {
-        cout << "[SYNC] Elementos en buffer: " << buffer.size() << " / " << capacidad << "\n";
-    }
-};
-
-
-// ------------------------- Cena de los Filosofos (simulada) ------------------------- //
-class FilosofoSimulado {
-private:
-    int id;
-    shared_ptr<Proceso> proceso;
-    SemaforoSimulado* tenedor_izq;
-    SemaforoSimulado* tenedor_der;
-
-public:
-    FilosofoSimulado(int _id, shared_ptr<Proceso> p, 
-                     SemaforoSimulado* izq, SemaforoSimulado* der)
-        : id(_id), proceso(p), tenedor_izq(izq), tenedor_der(der) {}
-
-    void ciclo() {
-        cout << "[Filosofo " << id << "] Pensando...\n";
-        this_thread::sleep_for(chrono::milliseconds(300));
-
-        cout << "[Filosofo " << id << "] Intenta tomar tenedores\n";
-        tenedor_izq->wait(proceso);
-        tenedor_der->wait(proceso);
-
-        if (proceso->estado != "BLOQUEADO") {
-            proceso->estado = "EJECUTANDO";
-            cout << "[Filosofo " << id << "] Comiendo\n";
-            this_thread::sleep_for(chrono::milliseconds(300));
-
-            tenedor_izq->signal();
-            tenedor_der->signal();
-            proceso->estado = "LISTO";
-            cout << "[Filosofo " << id << "] Termina de comer y suelta tenedores\n";
-        } else {
-            cout << "[Filosofo " << id << "] Bloqueado esperando tenedores...\n";
-        }
-    }
-
-    string estado() const { return proceso->estado; }
-    int getId() const { return proceso->id_proceso; }
-};
-
-
-// ------------------------- Simulacion de la cena -------------------------
-void simular_cena_filosofos(int N = 5, int rondas = 3) {
-    cout << "\n=== Simulacion: Cena de los Filosofos ===\n";
-
-    vector<SemaforoSimulado> tenedores(N, SemaforoSimulado(1));
-    vector<shared_ptr<Proceso>> procesos;
-    vector<FilosofoSimulado> filosofos;
-
-    // Crear filosofos y procesos
-    for (int i = 0; i < N; ++i) {
-        auto p = make_shared<Proceso>(i+1, 1, 0); // id_proceso, tiempo, llegada
-        procesos.push_back(p);
-        filosofos.emplace_back(i, p, &tenedores[i], &tenedores[(i + 1) % N]);
-    }
-
-    // Simular varias rondas
-    for (int r = 0; r < rondas; ++r) {
-        cout << "\n--- RONDA " << r + 1 << " ---\n";
-        for (auto &f : filosofos) f.ciclo();
-
-        cout << "\nEstado tras ronda " << r + 1 << ":\n";
-        for (auto &f : filosofos) {
-            cout << "  Filosofo " << f.getId() << " -> " << f.estado() << "\n";
-        }
-    }
-
-    cout << "\n=== Fin de la simulacion de los filosofos ===\n";
-}
-
-
-// ------------------------- Solicitud de E/S con prioridad -------------------------
-struct SolicitudIO {
-    int prioridad;
-    shared_ptr<Proceso> proceso;
-    int duracion;
-    int tiempo_inicio;
-    int tiempo_restante;
-
-    bool operator<(const SolicitudIO& other) const {
-        // prioridad más alta -> primero (menor numero = mayor prioridad)
-        return prioridad > other.prioridad;
-    }
-};
-
-
-// ------------------------- Dispositivos Simulados (E/S con prioridad) -------------------------
-class DispositivoSimulado {
-private:
-    string nombre;
-    bool ocupado;
-    priority_queue<SolicitudIO> cola;
-    optional<SolicitudIO> en_ejecucion;
-    PlanificadorRR* planificador; // para reinsertar procesos al finalizar
-
-public:
-    DispositivoSimulado()
-        : nombre(""), ocupado(false), planificador(nullptr) {}
-
-    DispositivoSimulado(string n, PlanificadorRR* p = nullptr)
-        : nombre(std::move(n)), ocupado(false), planificador(p) {}
-
-    void setPlanificador(PlanificadorRR* p) { planificador = p; }
-
-    void solicitar(shared_ptr<Proceso> proceso, int duracion, int prioridad) {
-        SolicitudIO req{prioridad, proceso, duracion, -1, duracion};
-        cola.push(req);
-        proceso->estado = "BLOQUEADO";
-        cout << "[IO] PID " << proceso->id_proceso << " solicita " << nombre
-             << " (dur=" << duracion << ", prio=" << prioridad << ")\n";
-    }
-
-    void tick() {
-        if (!ocupado) {
-            if (!cola.empty()) {
-                en_ejecucion = cola.top();
-                cola.pop();
-                ocupado = true;
-                en_ejecucion->tiempo_inicio = 0;
-                cout << "[IO] " << nombre << " atendiendo PID "
-                     << en_ejecucion->proceso->id_proceso << "\n";
-            }
-            return;
-        }
-
-        if (en_ejecucion) {
-            en_ejecucion->tiempo_restante--;
-            if (en_ejecucion->tiempo_restante <= 0) {
-                cout << "[IO] PID " << en_ejecucion->proceso->id_proceso
-                     << " termino en " << nombre << "\n";
-                en_ejecucion->proceso->estado = "LISTO";
-                if (planificador)
-                    planificador->enqueue_ready(en_ejecucion->proceso);
-                ocupado = false;
-                en_ejecucion.reset();
-            }
-        }
-    }
-
-    void estado() const {
-        cout << "[IO] " << nombre << " -> "
-             << (ocupado ? "OCUPADO" : "LIBRE")
-             << " | Cola: " << cola.size() << " solicitudes\n";
-    }
-};
-
-
-// --------------- Gestor Dispositivos (Simulados) ------------------ //
-class GestorDispositivos {
-private:
-    map<string, DispositivoSimulado> dispositivos;
-
-public:
-    GestorDispositivos(PlanificadorRR* planificador) {
-        dispositivos["disco"] = DispositivoSimulado("Disco", planificador);
-        dispositivos["red"]   = DispositivoSimulado("Red", planificador);
-        dispositivos["usb"]   = DispositivoSimulado("USB", planificador);
-    }
-
-    void solicitar(const string& nombre, shared_ptr<Proceso> p, int duracion, int prioridad) {
-        if (!dispositivos.count(nombre)) {
-            cout << "[!] Dispositivo '" << nombre << "' no existe\n";
-            return;
-        }
-        dispositivos[nombre].solicitar(p, duracion, prioridad);
-    }
-
-    void tick() {
-        for (auto& kv : dispositivos) kv.second.tick();
-    }
-
-    void estado() const {
-        cout << "\n=== Estado de dispositivos ===\n";
-        for (auto& kv : dispositivos) kv.second.estado();
-    }
-};
-
-
-// ------------------------- Impresora Simulada -------------------------
-class ImpresoraSimulada {
-private:
-    deque<pair<int, string>> cola_impresion; // (pid, contenido)
-    size_t capacidad;
-    SemaforoSimulado sem_vacio;  // capacidad disponible
-    SemaforoSimulado sem_ocupado; // trabajos en cola
-    mutex mtx; // control de concurrencia simulada
-public:
-    ImpresoraSimulada(size_t cap = 3)
-        : capacidad(cap), sem_vacio((int)cap), sem_ocupado(0) {}
-
-    // Proceso solicita imprimir algo
-    bool producir_impresion(shared_ptr<Proceso> p, const string &contenido) {
-        lock_guard<mutex> lock(mtx);
-
-        if (cola_impresion.size() < capacidad) {
-            cola_impresion.push_back({p->id_proceso, contenido});
-            cout << "[IMPRESORA] Proceso " << p->id_proceso 
-                 << " envia trabajo: '" << contenido << "'\n";
-            sem_ocupado.signal();
-            return true;
-        } else {
-            cout << "[IMPRESORA] Cola llena. Proceso " << p->id_proceso 
-                 << " bloqueado (esperando turno)...\n";
-            p->estado = "BLOQUEADO";
-            return false;
-        }
-    }
-
-    // Impresora procesa un trabajo (simula consumo)
-    bool procesar_impresion() {
-        lock_guard<mutex> lock(mtx);
-
-        if (!cola_impresion.empty()) {
-            auto trabajo = cola_impresion.front();
-            cola_impresion.pop_front();
-            sem_vacio.signal();
-
-            cout << "[IMPRESORA] Imprimiendo trabajo de PID " << trabajo.first
-                 << " -> \"" << trabajo.second << "\"\n";
-            this_thread::sleep_for(chrono::milliseconds(300));
-            cout << "[IMPRESORA] Trabajo de PID " << trabajo.first << " completado\n";
-            return true;
-        } else {
-            cout << "[IMPRESORA] No hay trabajos pendientes.\n";
-            return false;
-        }
-    }
-
-    void estado() const {
-        cout << "\n[IMPRESORA] Estado actual:\n";
-        cout << " Trabajos en cola: " << cola_impresion.size() 
-             << " / " << capacidad << "\n";
-        for (auto &t : cola_impresion) {
-            cout << "  PID " << t.first << " -> \"" << t.second << "\"\n";
-        }
-    }
-};
-
-
-// ------------------------- Simulacion de planificacion de disco -------------------------
-class SimuladorDisco {
-private:
-    vector<int> solicitudes;
-    int posicion_inicial;
-    int movimiento_total;
-
-    void graficar_recorrido(const vector<int>& recorrido, const string& nombre_algoritmo) {
-        cout << "\n[GRAFICO] Recorrido del cabezal (" << nombre_algoritmo << ")\n";
-        cout << "Cilindros: ";
-        for (int c : recorrido) cout << c << " ";
-        cout << "\n\nEje aproximado (posicion del cabezal por orden de acceso):\n";
-
-        int min_c = *min_element(recorrido.begin(), recorrido.end());
-        int max_c = *max_element(recorrido.begin(), recorrido.end());
-        int rango = max_c - min_c + 1;
-
-        for (size_t i = 0; i < recorrido.size(); ++i) {
-            int offset = (int)((double)(recorrido[i] - min_c) / rango * 60); // ancho aproximado
-            cout << setw(2) << i+1 << " | " << string(offset, '-') << "*(" << recorrido[i] << ")\n";
-        }
-    }
-
-public:
-    SimuladorDisco(vector<int> reqs, int pos_inicial)
-        : solicitudes(reqs), posicion_inicial(pos_inicial), movimiento_total(0) {}
-
-    void ejecutar_FCFS() {
-        cout << "\n[DISK] Algoritmo FCFS\n";
-        int pos = posicion_inicial;
-        movimiento_total = 0;
-        vector<int> recorrido = {pos};
-
-        for (int r : solicitudes) {
-            int movimiento = abs(r - pos);
-            cout << "  Cabezal: " << pos << " -> " << r
-                 << " (mov=" << movimiento << ")\n";
-            movimiento_total += movimiento;
-            pos = r;
-            recorrido.push_back(pos);
-        }
-        cout << "Movimiento total FCFS: " << movimiento_total << "\n";
-        graficar_recorrido(recorrido, "FCFS");
-    }
-
-    void ejecutar_SSTF() {
-        cout << "\n[DISK] Algoritmo SSTF\n";
-        vector<int> pendientes = solicitudes;
-        int pos = posicion_inicial;
-        movimiento_total = 0;
-        vector<int> recorrido = {pos};
-
-        while (!pendientes.empty()) {
-            auto it = min_element(pendientes.begin(), pendientes.end(),
-                                  [pos](int a, int b) {
-                                      return abs(a - pos) < abs(b - pos);
-                                  });
-            int r = *it;
-            int movimiento = abs(r - pos);
-            cout << "  Cabezal: " << pos << " -> " << r
-                 << " (mov=" << movimiento << ")\n";
-            movimiento_total += movimiento;
-            pos = r;
-            recorrido.push_back(pos);
-            pendientes.erase(it);
-        }
-        cout << "Movimiento total SSTF: " << movimiento_total << "\n";
-        graficar_recorrido(recorrido, "SSTF");
-    }
-
-    void ejecutar_SCAN(bool hacia_derecha = true, int max_cilindro = 199) {
-        cout << "\n[DISK] Algoritmo SCAN (" << (hacia_derecha ? "→ derecha" : "← izquierda") << ")\n";
-        vector<int> menores, mayores;
-        int pos = posicion_inicial;
-        movimiento_total = 0;
-
-        for (int r : solicitudes) {
-            if (r < pos) menores.push_back(r);
-            else mayores.push_back(r);
-        }
-        sort(menores.begin(), menores.end());
-        sort(mayores.begin(), mayores.end());
-
-        vector<int> recorrido = {pos};
-
-        if (hacia_derecha) {
-            for (int r : mayores) recorrido.push_back(r);
-            recorrido.push_back(max_cilindro);
-            for (int i = (int)menores.size() - 1; i >= 0; --i) recorrido.push_back(menores[i]);
-        } else {
-            for (int i = (int)menores.size() - 1; i >= 0; --i) recorrido.push_back(menores[i]);
-            recorrido.push_back(0);
-            for (int r : mayores) recorrido.push_back(r);
-        }
-
-        for (size_t i = 1; i < recorrido.size(); ++i) {
-            int mov = abs(recorrido[i] - recorrido[i - 1]);
-            cout << "  Cabezal: " << recorrido[i - 1] << " -> " << recorrido[i]
-                 << " (mov=" << mov << ")\n";
-            movimiento_total += mov;
-        }
-
-        cout << "Movimiento total SCAN: " << movimiento_total << "\n";
-        graficar_recorrido(recorrido, "SCAN");
-    }
-    void visualizar_linea_disco(int max_cilindro = 199, int ancho = 80) {
-        cout << "\n[Visualizacion Disco - Linea de Cilindros]\n";
-
-        int pos = posicion_inicial;
-        vector<char> linea(ancho, '-');
-
-        // Mapea los cilindros solicitados en la linea
-        for (int r : solicitudes) {
-            int idx = (r * ancho) / max_cilindro;
-            if (idx >= 0 && idx < ancho) linea[idx] = '|';
-        }
-
-        // Marca el cabezal
-        int pos_idx = (pos * ancho) / max_cilindro;
-        if (pos_idx >= 0 && pos_idx < ancho) linea[pos_idx] = 'O';
-
-        // Render
-        for (char c : linea) cout << c;
-        cout << "\nPosicion cabezal: " << pos
-            << " | Solicitudes: " << solicitudes.size() << "\n";
-    }
-
-};
-
-
 // ------------------------- CLI y main -------------------------
 int main() {
-    PlanificadorRR planificador_rr(2);         // quantum = 2
-    PlanificadorSJF planificador_sjf;
-    GestorMarcos gestor(3);                 // 3 marcos por defecto
-    bool modo_lru = false;
-    ProductorConsumidorSimulado sync_sim(5);
-    ImpresoraSimulada impresora(3);
+    RegistroEventos traza;                  // sumidero comun de eventos
+    PlanificadorRR planificador_rr(2, &traza);         // quantum = 2
+    PlanificadorSJF planificador_sjf(&traza);
+    PlanificadorCFS planificador_cfs(&traza);          // latencia 24, granularidad 3 (comando cfs)
+    TrazaAccesos traza_accesos;             // anillo de memtrace y traza completa opcional
+    // cada planificador numera sus PIDs desde 1 en su propia tabla, asi que cada uno tiene su
+    // propia memoria (3 marcos por defecto). memtlb y memmode reiniciar configuran las tres;
+    // un memmode sin reiniciar se aplica a las otras cuando su planificador pasa a ser el actual
+    GestorMarcos memoria_rr(3, PoliticaMemoria::FIFO, 5, &traza, &traza_accesos);
+    GestorMarcos memoria_sjf(3, PoliticaMemoria::FIFO, 5, &traza, &traza_accesos);
+    GestorMarcos memoria_cfs(3, PoliticaMemoria::FIFO, 5, &traza, &traza_accesos);
+    GestorMarcos *const memorias[] = {&memoria_rr, &memoria_sjf, &memoria_cfs};
+    ConfigTLB config_tlb;                   // sin TLB hasta 'memtlb'
+    ProductorConsumidorSimulado sync_sim(5, &traza);
+    int modo_planificador = 1; // 1=RR, 2=SJF, 3=CFS
+    // PID del planificador actual (cada uno tiene su propia tabla de procesos)
+    auto buscar_proceso = [&](int pid) -> HandleProceso {
+        if (modo_planificador == 1) return planificador_rr.obtener_proceso(pid);
+        if (modo_planificador == 3) return planificador_cfs.obtener_proceso(pid);
+        return planificador_sjf.obtener_proceso(pid);
+    };
+    auto memoria_actual = [&]() -> GestorMarcos & {
+        if (modo_planificador == 1) return memoria_rr;
+        if (modo_planificador == 3) return memoria_cfs;
+        return memoria_sjf;
+    };
+    // un proceso que se desbloquea vuelve a la cola del planificador dueño de su tabla
+    ReencolarProceso reencolar = [&](HandleProceso p) {
+        if (planificador_rr.es_propio(p)) planificador_rr.enqueue_ready(p.pid);
+        else if (planificador_sjf.es_propio(p)) planificador_sjf.enqueue_ready(p.pid);
+        else if (planificador_cfs.es_propio(p)) planificador_cfs.enqueue_ready(p.pid);
+    };
+    ImpresoraSimulada impresora(3, &traza);
+    impresora.set_reencolar(reencolar);
+    sync_sim.set_reencolar(reencolar);
+    // semaforos con nombre para sem_wait/sem_signal/semstat; los de la impresora son internos
+    // (un wait desde la consola la dejaria sin poder tomar trabajos) y semstat solo los muestra
+    vector<pair<string, SemaforoSimulado *>> semaforos = {
+        {"pc_vacio", &sync_sim.semaforo_vacio()}, {"pc_item", &sync_sim.semaforo_item()}};
+    auto buscar_semaforo = [&](const string &nombre) -> SemaforoSimulado * {
+        for (auto &[n, s] : semaforos)
+            if (n == nombre) return s;
+        return nullptr;
+    };
 
-    int modo_planificador = 1; // 1=RR, 2=SJF
-    GestorDispositivos gestor_io(&planificador_rr);
+    GestorDispositivos gestor_io(reencolar, &traza);
+    CargaTrabajo carga_sesion;                         // new/mem de la sesion, para sweep
+    PoolHilos pool;
 
 
     cout << "=== SIMULADOR DE KERNEL ===\n";
     cout << "Seleccionar planificador inicial:\n"
          << "  1 -> Round Robin (RR)\n"
          << "  2 -> Shortest Job First (SJF)\n"
+         << "  3 -> Completely Fair Scheduler (CFS)\n"
          << "Opcion: ";
     cin >> modo_planificador;
     cin.ignore();
 
     cout << "\n[!] Planificador actual: " 
-         << (modo_planificador == 1 ? "Round Robin (RR)" : "Shortest Job First (SJF)") << "\n\n";
+         << (modo_planificador == 1 ? "Round Robin (RR)"
+             : modo_planificador == 3 ? "Completely Fair Scheduler (CFS)" : "Shortest Job First (SJF)") << "\n\n";
 
     cout << "=== SIMULADOR DE KERNEL ===\n";
     cout << "Comandos:\n"
-         << "  new <tiempo> [llegada_offset]    -> crea proceso\n"
+         << "  new <tiempo> [llegada] [nice]    -> crea proceso (nice solo en CFS)\n"
          << "  run <ticks>                      -> ejecuta planificador N ticks\n"
          << "  tick                             -> avanza 1 tick\n"
          << "  ps                               -> lista procesos\n"
          << "  stats                            -> metricas generales\n"
          << "  kill <id>                        -> termina proceso manualmente\n"
-         << "  modo <rr|sjf>                    -> cambia planificador\n"
-         << "  mem <pid> <pag>                  -> acceder pagina (usa GestorMarcos)\n"
-         << "  memmode <fifo|lru|ws> [marcos]   -> cambia politica y opcional marcos\n"
-         << "  filosofos                        -> simular la cena de los filosofos\n"
+         << "  modo <rr|sjf|cfs>                -> cambia planificador\n"
+         << "  nice <pid> <n>                   -> cambia el nice (-20..19) de un proceso en CFS\n"
+         << "  cfs <latencia> <granularidad>    -> latencia objetivo y granularidad minima de CFS (ticks)\n"
+         << "  cpus <n>                         -> cantidad de CPUs simuladas (colas por CPU)\n"
+         << "  mem <pid> <pag> [r|w]            -> acceder pagina (lectura o escritura)\n"
+         << "  memmode <politica> [marcos]      -> fifo|lru|ws|clock|sc|aging y opcional marcos, en caliente\n"
+         << "  memmode ... reiniciar            -> descarta paginas residentes y contadores\n"
+         << "  fork <pid>                       -> crea un hijo que comparte las paginas (copy-on-write)\n"
+         << "  memseg <seg> <pid> <base> [pags] -> mapea un segmento compartido en las paginas base..\n"
+         << "  devadd <nombre> <tipo> [cant]    -> crea dispositivo(s) de E/S: disco|red|usb|otro\n"
+         << "  io <disp> <pid> <dur> <prio>     -> solicitud de E/S (el proceso queda bloqueado)\n"
+         << "  iotick [n]                       -> avanza n ticks la E/S\n"
+         << "  iostat [nombre|n]                -> utilizacion, cola y latencias (p50/p99) de los dispositivos\n"
+         << "  filosofos [n] [rondas] [pausa_ms] -> simular la cena de los filosofos\n"
+         << "  cena <estrategia|todas> [n] [comidas] [pensar_us] [comer_us] -> cena con hilos reales\n"
          << "  print <pid> <texto>              -> proceso solicita imprimir\n"
-         << "  printproc                        -> impresora procesa un trabajo\n"
+         << "  printproc [ticks]                -> avanza la impresora hasta el proximo trabajo (o n ticks)\n"
+         << "  printlote <n>                    -> trabajos que la impresora toma por lote\n"
          << "  printstat                        -> mostrar estado actual de la cola\n"
          << "  memstat                          -> mostrar estado memoria\n"
-         << "  memtrace                         -> mostrar trazas memoria\n"
+         << "  memload <archivo>                -> reproduce una traza de accesos (texto, gen o memtrace archivo)\n"
+         << "  memtlb <entradas> [vias] [lru|rand] [flush|asid] -> TLB delante de la tabla (memtlb off)\n"
+         << "  memtrace [n]                     -> ultimos n accesos a memoria (anillo acotado)\n"
+         << "  memtrace <on|off>                -> activa o apaga todo el registro de accesos\n"
+         << "  memtrace archivo <ruta|off>      -> traza completa columnar comprimida a archivo (mmap)\n"
          << "  memstats <pid>                   -> mostrar stats de un proceso (accesos/fallos)\n"
+         << "  memcurva [carga] [max] [opt]     -> curva de fallos LRU (una pasada) y OPT para 1..max marcos\n"
+         << "  sem_wait <name> <pid>            -> wait de un proceso en semaforo predef (puede bloquearlo)\n"
          << "  sem_signal <name>                -> (simulado) signal en semaforo predef\n"
+         << "  semstat                          -> valor, esperas, bloqueos y cola de cada semaforo\n"
          << "  produce <x>                      -> producir item en buffer (simulado)\n"
          << "  consume                          -> consumir item del buffer (simulado)\n"
          << "  bufstat                          -> estado buffer sincronizacion\n"
+         << "  pchilos <spsc|mpmc|mutex|todos> [prod] [cons] [cap] [items] -> productor-consumidor con hilos reales\n"
          << "  memview                          -> vista ASCII de marcos de memoria (color HIT/MISS)\n"
          << "  disk <fcfs|sstf|scan>            -> ejecuta simulacion de disco y visualizacion ASCII\n"
+         << "  gen <archivo> <n> [clave=valor]  -> genera carga sintetica binaria (ver README)\n"
+         << "  load <archivo>                   -> carga binaria (mmap) en el planificador actual\n"
+         << "  sweep cpu [qmin] [qmax]          -> compara RR (quantum qmin..qmax), SJF y CFS en paralelo\n"
+         << "  sweep mem [mmin] [mmax] [vent]   -> compara las 6 politicas con mmin..mmax marcos\n"
+         << "  sweep tlb [qmin] [qmax] [marcos] -> tasa de aciertos del TLB por quantum RR (vaciado vs ASID)\n"
+         << "  sweep carga <archivo>            -> carga para sweep desde archivo (lineas new/mem)\n"
+         << "  benchsjf [n]                     -> benchmark SJF: sort vs heap con n trabajos\n"
+         << "  log [off|resumen|eventos|ticks]  -> nivel de la traza de eventos (consola/archivo)\n"
+         << "  log archivo <ruta|off>           -> escribe la traza a archivo en segundo plano\n"
          << "  exit\n";
 
     string linea;
@@ -1030,34 +129,62 @@ int main() {
         stringstream ss(linea);
         string cmd;
         ss >> cmd;
+        GestorMarcos &gestor = memoria_actual();
 
         // Creacion de procesos 
         if (cmd == "new") {
-            int t; int off = 0;
+            int t; int off = 0; int valor_nice = 0;
             ss >> t;
-            if (ss.fail()) { cout << "Uso: new <tiempo> [llegada_offset]\n"; continue; }
+            if (ss.fail()) { cout << "Uso: new <tiempo> [llegada_offset] [nice]\n"; continue; }
             if (!(ss >> off)) off = 0;
-            if (modo_planificador == 1)
-                planificador_rr.crear_proceso(t, off);
-            else
-                planificador_sjf.crear_proceso(t, off);
+            if (!(ss >> valor_nice)) valor_nice = 0;
+            if (modo_planificador == 1) {
+                int ahora = planificador_rr.get_tiempo();
+                int id = planificador_rr.crear_proceso(t, off);
+                if (off <= 0) cout << "[+] Proceso creado (RR) | id=" << id << " tiempo=" << t << " (LISTO)\n";
+                else cout << "[+] Proceso creado con llegada futura | id=" << id << " tiempo=" << t
+                          << " llegada=" << sumar_reloj(ahora, off) << "\n";
+                carga_sesion.procesos.push_back({t, sumar_reloj(ahora, off)});
+            } else if (modo_planificador == 3) {
+                int ahora = planificador_cfs.get_tiempo();
+                int id = planificador_cfs.crear_proceso(t, off, valor_nice);
+                if (off <= 0) cout << "[+] Proceso creado (CFS) | id=" << id << " tiempo=" << t << " nice=" << valor_nice << "\n";
+                else cout << "[+] Proceso creado con llegada futura (CFS) | id=" << id << " tiempo=" << t
+                          << " nice=" << valor_nice << " llegada=" << sumar_reloj(ahora, off) << "\n";
+                carga_sesion.procesos.push_back({t, sumar_reloj(ahora, off)});
+            } else {
+                int ahora = planificador_sjf.get_tiempo();
+                int id = planificador_sjf.crear_proceso(t, off);
+                if (off <= 0) cout << "[+] Proceso creado (SJF) | id=" << id << " tiempo=" << t << "\n";
+                else cout << "[+] Proceso creado con llegada futura (SJF) | id=" << id << " tiempo=" << t
+                          << " llegada=" << sumar_reloj(ahora, off) << "\n";
+                carga_sesion.procesos.push_back({t, sumar_reloj(ahora, off)});
+            }
         } 
         // Ejecucion de ticks
         else if (cmd == "run") {
             int n; ss >> n;
             if (ss.fail()) { cout << "run <ticks>\n"; continue; }
+            int hechos;
             if (modo_planificador == 1)
-                planificador_rr.ejecutar_ticks(n, gestor, modo_lru);
+                hechos = planificador_rr.ejecutar_ticks(n, gestor);
+            else if (modo_planificador == 3)
+                hechos = planificador_cfs.ejecutar_ticks(n, gestor);
             else
-                planificador_sjf.ejecutar_ticks(n, gestor, modo_lru);
+                hechos = planificador_sjf.ejecutar_ticks(n, gestor);
+            if (hechos < n)
+                cout << "[!] El reloj simulado llego a su maximo (" << INT_MAX << "): se ejecutaron " << hechos
+                     << " de " << n << " ticks\n";
         }
 
         // Tick individual
         else if (cmd == "tick") {
             if (modo_planificador == 1)
-                planificador_rr.tick(gestor, modo_lru);
+                planificador_rr.tick(gestor);
+            else if (modo_planificador == 3)
+                planificador_cfs.tick(gestor);
             else
-                planificador_sjf.tick(gestor, modo_lru);
+                planificador_sjf.tick(gestor);
         }
         // Solicitud de E/S
         else if (cmd == "io") {
@@ -1065,25 +192,60 @@ int main() {
             ss >> dev >> pid >> dur >> prio;
             if (ss.fail()) { cout << "Uso: io <dispositivo> <pid> <duracion> <prioridad>\n"; continue; }
 
-            auto p = planificador_rr.obtener_proceso(pid);
+            auto p = buscar_proceso(pid);
             if (!p) { cout << "[!] No existe proceso " << pid << "\n"; continue; }
 
             gestor_io.solicitar(dev, p, dur, prio);
         }
 
+        // Alta de dispositivos: 'cantidad' crea nombre0..nombreN-1
+        else if (cmd == "devadd") {
+            string nombre, tipo_txt;
+            TipoDispositivo tipo;
+            int cantidad = 1;
+            ss >> nombre >> tipo_txt;
+            if (ss.fail() || !tipo_dispositivo_desde_texto(tipo_txt, tipo)) {
+                cout << "Uso: devadd <nombre> <disco|red|usb|otro> [cantidad]\n";
+                continue;
+            }
+            if (!(ss >> cantidad)) cantidad = 1;
+            if (cantidad < 1 || cantidad > 1000000) { cout << "[!] cantidad fuera de rango (1..1000000)\n"; continue; }
+            int primero = -1, creados = 0;
+            for (int i = 0; i < cantidad; ++i) {
+                int d = gestor_io.agregar(cantidad == 1 ? nombre : nombre + to_string(i), tipo);
+                if (d < 0) continue;
+                if (primero < 0) primero = d;
+                creados++;
+            }
+            if (!creados) { cout << "[!] Ya existe un dispositivo '" << nombre << "'\n"; continue; }
+            cout << "[+] " << creados << " dispositivo(s) " << tipo_txt << " (handle " << primero
+                 << (creados > 1 ? ".." + to_string(primero + creados - 1) : "") << ")";
+            if (creados < cantidad) cout << ", " << cantidad - creados << " nombres ya existian";
+            cout << "\n";
+        }
+
         // Avanzar tick de E/S
         else if (cmd == "iotick") {
-            gestor_io.tick();
+            int n = 1;
+            if (!(ss >> n) || n < 1) n = 1;
+            gestor_io.avanzar(n);
+            if (n > 1) cout << "[IO] t=" << gestor_io.get_tiempo() << ", " << gestor_io.pendientes()
+                            << " solicitudes pendientes\n";
         }
 
         // Mostrar estado de dispositivos
         else if (cmd == "iostat") {
-            gestor_io.estado();
+            string arg;
+            if (!(ss >> arg)) gestor_io.estado();
+            else if (all_of(arg.begin(), arg.end(), ::isdigit) && gestor_io.buscar(arg) < 0) gestor_io.estado(stoul(arg));
+            else gestor_io.estado(arg);
         }
         // Listar procesos
         else if (cmd == "ps") {
             if (modo_planificador == 1)
                 planificador_rr.listar_procesos();
+            else if (modo_planificador == 3)
+                planificador_cfs.listar_procesos();
             else
                 planificador_sjf.listar_procesos();
         }
@@ -1092,19 +254,169 @@ int main() {
         else if (cmd == "stats") {
             if (modo_planificador == 1)
                 planificador_rr.estadisticas_generales();
+            else if (modo_planificador == 3)
+                planificador_cfs.estadisticas_generales();
             else
-                cout << "[SJF] (No implementadas estadisticas globales aun)\n";
+                planificador_sjf.estadisticas_generales();
         }
 
         // Terminar proceso
         else if (cmd == "kill") {
             int id; ss >> id;
             if (ss.fail()) { cout << "kill <id>\n"; continue; }
-            if (modo_planificador == 1) {
+            // sale de toda cola de semaforo: un signal posterior no debe revivirlo
+            if (HandleProceso p = buscar_proceso(id)) {
+                for (auto &kv : semaforos) kv.second->retirar(p);
+                impresora.retirar_proceso(p);
+            }
+            if (modo_planificador == 1)
                 planificador_rr.terminar_proceso(id);
-                gestor.liberar_proceso(id);
+            else if (modo_planificador == 3)
+                planificador_cfs.terminar_proceso(id);
+            else
+                planificador_sjf.terminar_proceso(id);
+            gestor.liberar_proceso(id);
+        }
+
+        // Prioridad relativa (peso) de un proceso en CFS
+        else if (cmd == "nice") {
+            int id, valor; ss >> id >> valor;
+            if (ss.fail()) { cout << "nice <pid> <n>  (-20..19)\n"; continue; }
+            if (modo_planificador != 3) { cout << "[!] nice solo aplica en modo CFS\n"; continue; }
+            if (!planificador_cfs.set_nice(id, valor)) { cout << "[!] No existe proceso activo " << id << "\n"; continue; }
+            cout << "[!] PID " << id << " nice=" << max(-20, min(19, valor)) << "\n";
+        }
+
+        // Parametros de CFS: latencia objetivo y granularidad minima
+        else if (cmd == "cfs") {
+            int latencia, granularidad;
+            ss >> latencia >> granularidad;
+            if (ss.fail() || latencia < 1 || granularidad < 1) {
+                cout << "Uso: cfs <latencia> <granularidad>  (ticks >= 1, actual: latencia="
+                     << planificador_cfs.get_latencia() << " granularidad=" << planificador_cfs.get_granularidad() << ")\n";
+                continue;
+            }
+            planificador_cfs.set_parametros(latencia, granularidad);
+            cout << "[!] CFS: latencia objetivo=" << latencia << " granularidad minima=" << granularidad << "\n";
+        }
+
+        // Cantidad de CPUs simuladas (todos los planificadores)
+        else if (cmd == "cpus") {
+            int n; ss >> n;
+            if (ss.fail() || n < 1 || n > 1024) {
+                cout << "Uso: cpus <n>  (1..1024, actual=" << planificador_rr.get_nucleos() << ")\n";
+                continue;
+            }
+            planificador_rr.set_nucleos(n);
+            planificador_sjf.set_nucleos(n);
+            planificador_cfs.set_nucleos(n);
+            cout << "[!] CPUs simuladas: " << n << "\n";
+        }
+
+        // Generador de cargas sinteticas (archivo binario)
+        else if (cmd == "gen") {
+            string ruta; ParametrosCarga par;
+            ss >> ruta >> par.n;
+            if (ss.fail()) {
+                cout << "Uso: gen <archivo> <n> [seed=S] [llegada=media] [rafaga=exp|pareto|bimodal] [media=M]"
+                     << " [paginas=K] [rango=R] [io=E]\n";
+                continue;
+            }
+            string token; bool ok = true;
+            while (ss >> token) {
+                size_t eq = token.find('=');
+                string clave = token.substr(0, eq), valor = eq == string::npos ? "" : token.substr(eq + 1);
+                try {
+                    if (clave == "seed") par.semilla = stoull(valor);
+                    else if (clave == "llegada") par.llegada_media = stod(valor);
+                    else if (clave == "media") par.rafaga_media = stod(valor);
+                    else if (clave == "paginas") par.paginas = stoi(valor);
+                    else if (clave == "rango") par.rango_paginas = max(1, stoi(valor));
+                    else if (clave == "io") par.io = stoi(valor);
+                    else if (clave == "rafaga" && valor == "exp") par.rafaga = DistribucionRafaga::EXPONENCIAL;
+                    else if (clave == "rafaga" && valor == "pareto") par.rafaga = DistribucionRafaga::PARETO;
+                    else if (clave == "rafaga" && valor == "bimodal") par.rafaga = DistribucionRafaga::BIMODAL;
+                    else ok = false;
+                } catch (...) { ok = false; }
+            }
+            if (!ok || par.paginas < 0 || par.io < 0) { cout << "[!] Parametro invalido en gen\n"; continue; }
+            auto t0 = chrono::steady_clock::now();
+            if (!generar_carga(ruta, par)) { cout << "[!] No se pudo escribir " << ruta << "\n"; continue; }
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+            cout << "[GEN] " << par.n << " procesos, " << par.n * par.paginas << " accesos, " << par.n * par.io
+                 << " E/S -> " << ruta << " (seed=" << par.semilla << ", " << fixed << setprecision(1) << ms << " ms)\n";
+        }
+
+        // Carga binaria mapeada en memoria: alta masiva en el planificador actual
+        else if (cmd == "load") {
+            string ruta; ss >> ruta;
+            if (ruta.empty()) { cout << "Uso: load <archivo>\n"; continue; }
+            auto t0 = chrono::steady_clock::now();
+            ArchivoMapeado m;
+            VistaCarga v;
+            if (!m.abrir(ruta) || !v.abrir(m)) { cout << "[!] " << ruta << " no es una carga valida (use gen)\n"; continue; }
+            size_t n = v.cab->n_procesos;
+            int ahora, primero;
+            if (modo_planificador == 1) {
+                ahora = planificador_rr.get_tiempo();
+                primero = planificador_rr.crear_procesos(n, v.tiempo, v.llegada);
+            } else if (modo_planificador == 3) {
+                ahora = planificador_cfs.get_tiempo();
+                primero = planificador_cfs.crear_procesos(n, v.tiempo, v.llegada);
+            } else {
+                ahora = planificador_sjf.get_tiempo();
+                primero = planificador_sjf.crear_procesos(n, v.tiempo, v.llegada);
+            }
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+            carga_sesion.agregar(v, ahora, primero);
+
+            // las E/S de la carga van a los procesos recien creados en el planificador actual
+            size_t e = v.cab->n_io;
+            for (size_t i = 0; i < e; ++i)
+                gestor_io.solicitar(DISPOSITIVOS_CARGA[v.io_dispositivo[i] % 3],
+                                    buscar_proceso(primero - 1 + (int)v.io_pid[i]),
+                                    (int)v.io_duracion[i], (int)v.io_prioridad[i]);
+            cout << "[LOAD] " << n << " procesos (PID " << primero << ".." << primero + (int)n - 1 << ") en "
+                 << fixed << setprecision(1) << ms << " ms | " << v.cab->n_accesos << " accesos para sweep/mem | "
+                 << e << " E/S\n";
+        }
+
+        // Barrido de parametros sobre la carga de la sesion (o una cargada de archivo)
+        else if (cmd == "sweep") {
+            string tipo; ss >> tipo;
+            if (tipo == "cpu") {
+                int qmin = 1, qmax = 64;
+                if (ss >> qmin) { if (!(ss >> qmax)) qmax = qmin; }
+                if (qmin < 1 || qmax < qmin) { cout << "Uso: sweep cpu [qmin] [qmax]\n"; continue; }
+                if (carga_sesion.procesos.empty()) { cout << "[!] La carga no tiene procesos (use new o sweep carga)\n"; continue; }
+                barrido_cpu(carga_sesion, qmin, qmax, planificador_rr.get_nucleos(), pool);
+            } else if (tipo == "mem") {
+                int mmin = 1, mmax = 256, ventana = 5;
+                if (ss >> mmin) { if (!(ss >> mmax)) mmax = mmin; }
+                if (!(ss >> ventana)) ventana = 5;
+                if (mmin < 1 || mmax < mmin) { cout << "Uso: sweep mem [mmin] [mmax] [ventana]\n"; continue; }
+                if (carga_sesion.accesos.empty()) { cout << "[!] La carga no tiene accesos (use mem o sweep carga)\n"; continue; }
+                barrido_memoria(carga_sesion, mmin, mmax, ventana, pool);
+            } else if (tipo == "tlb") {
+                int qmin = 1, qmax = 16, marcos = 256;
+                if (ss >> qmin) { if (!(ss >> qmax)) qmax = qmin; }
+                if (!(ss >> marcos)) marcos = 256;
+                if (qmin < 1 || qmax < qmin || marcos < 1) { cout << "Uso: sweep tlb [qmin] [qmax] [marcos]\n"; continue; }
+                if (carga_sesion.procesos.empty() || carga_sesion.accesos.empty()) {
+                    cout << "[!] La carga necesita procesos y accesos (use new/mem o sweep carga)\n";
+                    continue;
+                }
+                ConfigTLB c = config_tlb;
+                if (c.entradas == 0) c = ConfigTLB{16, 4, ReemplazoTLB::LRU, false};
+                barrido_tlb(carga_sesion, qmin, qmax, c, marcos, pool);
+            } else if (tipo == "carga") {
+                string ruta; ss >> ruta;
+                if (ruta.empty() || !carga_sesion.cargar(ruta)) { cout << "[!] No se pudo leer la carga\n"; continue; }
+                cout << "[SWEEP] Carga: " << carga_sesion.procesos.size() << " procesos, "
+                     << carga_sesion.accesos.size() << " accesos\n";
             } else {
-                cout << "[SJF] Terminacion manual no implementada.\n";
+                cout << "Uso: sweep cpu [qmin] [qmax] | sweep mem [mmin] [mmax] [ventana] | sweep tlb [qmin] [qmax] [marcos]"
+                     << " | sweep carga <archivo>\n";
             }
         }
 
@@ -1117,58 +429,211 @@ int main() {
             } else if (modo == "sjf") {
                 modo_planificador = 2;
                 cout << "[!] Cambiado a Shortest Job First (SJF)\n";
+            } else if (modo == "cfs") {
+                modo_planificador = 3;
+                cout << "[!] Cambiado a Completely Fair Scheduler (CFS)\n";
             } else {
-                cout << "Uso: modo <rr|sjf>\n";
+                cout << "Uso: modo <rr|sjf|cfs>\n";
+                continue;
             }
+            // la memoria del planificador nuevo toma la configuracion de memmode vigente
+            GestorMarcos &nueva = memoria_actual();
+            if (nueva.get_max_marcos() != gestor.get_max_marcos() || nueva.get_politica() != gestor.get_politica() ||
+                nueva.get_ventana() != gestor.get_ventana())
+                nueva.reconfigurar(gestor.get_max_marcos(), gestor.get_politica(), gestor.get_ventana());
         }
 
         // Memoria
         else if (cmd == "mem") {
-            int pid, pag;
+            int pid, pag; string tipo = "r";
             ss >> pid >> pag;
-            if (ss.fail()) { cout << "mem <pid> <pag>\n"; continue; }
+            if (ss.fail()) { cout << "mem <pid> <pag> [r|w]\n"; continue; }
+            if (!(ss >> tipo)) tipo = "r";
+            if (tipo != "r" && tipo != "w") { cout << "mem <pid> <pag> [r|w]\n"; continue; }
 
-            shared_ptr<Proceso> p;
+            HandleProceso p;
             if (modo_planificador == 1) p = planificador_rr.obtener_proceso(pid);
+            else if (modo_planificador == 3) p = planificador_cfs.obtener_proceso(pid);
             else cout << "[!] Acceso memoria no disponible en modo SJF\n";
 
             if (!p) { cout << "[!] No existe proceso " << pid << "\n"; continue; }
+            if (gestor.suspendido(pid)) {
+                cout << "[!] PID " << pid << " suspendido por control de carga (working sets > marcos)\n";
+                continue;
+            }
 
             bool hit = false;
-            int tiempo_acceso = gestor.acceder_pagina(pid, pag, modo_lru, hit);
-            cout << (hit ? "[MEM] HIT " : "[MEM] MISS ")
-                 << " PID " << pid << " Pag " << pag
-                 << " (tiempo_sim=" << tiempo_acceso << " ticks)\n";
+            gestor.acceder_pagina(pid, pag, hit, tipo == "w");
+            carga_sesion.accesos.push_back({pid, pag});
+        }
+
+        // fork copy-on-write: el hijo hereda el tiempo restante y comparte las paginas del padre
+        else if (cmd == "fork") {
+            int pid; ss >> pid;
+            if (ss.fail()) { cout << "fork <pid>\n"; continue; }
+            HandleProceso p = buscar_proceso(pid);
+            if (!p || p.estado() == EstadoProceso::TERMINADO) { cout << "[!] No existe proceso activo " << pid << "\n"; continue; }
+
+            int restante = p.tabla->tiempo_restante[pid], hijo, ahora;
+            if (modo_planificador == 1) {
+                ahora = planificador_rr.get_tiempo();
+                hijo = planificador_rr.crear_proceso(restante);
+            } else if (modo_planificador == 3) {
+                ahora = planificador_cfs.get_tiempo();
+                hijo = planificador_cfs.crear_proceso(restante, 0, planificador_cfs.get_nice(pid));
+            } else {
+                ahora = planificador_sjf.get_tiempo();
+                hijo = planificador_sjf.crear_proceso(restante);
+            }
+            carga_sesion.procesos.push_back({restante, ahora});
+            int compartidas = gestor.fork(pid, hijo);
+            cout << "[+] fork: PID " << hijo << " hijo de " << pid << " (tiempo=" << restante << ", "
+                 << compartidas << " paginas compartidas copy-on-write)\n";
+        }
+
+        // Segmento compartido (biblioteca, memoria compartida) mapeado en un proceso
+        else if (cmd == "memseg") {
+            int seg, pid, base, paginas = 0;
+            ss >> seg >> pid >> base;
+            if (ss.fail() || seg < 0 || base < 0) { cout << "memseg <segmento> <pid> <pag_base> [paginas]\n"; continue; }
+            ss >> paginas; // solo al crear el segmento
+            if (paginas < 0 || paginas > (1 << 20)) { cout << "[!] paginas debe estar entre 1 y " << (1 << 20) << "\n"; continue; }
+
+            HandleProceso p;
+            if (modo_planificador == 1) p = planificador_rr.obtener_proceso(pid);
+            else if (modo_planificador == 3) p = planificador_cfs.obtener_proceso(pid);
+            else { cout << "[!] Acceso memoria no disponible en modo SJF\n"; continue; }
+            if (!p) { cout << "[!] No existe proceso " << pid << "\n"; continue; }
+
+            int n = gestor.mapear_segmento(pid, seg, base, paginas);
+            if (n < 0) cout << "[!] El rango se superpone con otro segmento del PID " << pid << "\n";
+            else cout << "[+] Segmento " << seg << " mapeado en PID " << pid << ": paginas " << base << ".." << base + n - 1 << "\n";
+        }
+
+        // Reproduccion masiva de una traza de accesos (sin salida por acceso)
+        else if (cmd == "memload") {
+            string ruta; ss >> ruta;
+            if (ruta.empty()) { cout << "Uso: memload <archivo>\n"; continue; }
+            long long fallos_antes = gestor.get_fallos();
+            long long escrituras_antes = gestor.get_escrituras_disco();
+            ResumenReproduccion r;
+            auto t0 = chrono::steady_clock::now();
+            if (!reproducir_traza_memoria(ruta, gestor, r)) { cout << "[!] No se pudo leer " << ruta << "\n"; continue; }
+            double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+            long long fallos = gestor.get_fallos() - fallos_antes;
+            cout << "[MEMLOAD] " << r.formato << ": " << r.accesos << " accesos en " << fixed << setprecision(1) << ms
+                 << " ms (" << setprecision(2) << (ms > 0 ? r.accesos / ms / 1000.0 : 0.0) << " M accesos/s)\n"
+                 << "[MEMLOAD] Fallos: " << fallos << " | Tasa fallos: " << setprecision(4)
+                 << (r.accesos ? (double)fallos / r.accesos : 0.0) << " | Escrituras a disco: "
+                 << gestor.get_escrituras_disco() - escrituras_antes << " | Ticks simulados: " << r.ticks << "\n";
+            if (r.ignorados) cout << "[!] " << r.ignorados << " entradas ignoradas (lineas invalidas o pid >= " << MAX_PID_TRAZA << ")\n";
         }
 
         // Configuracion memoria
         else if (cmd == "memmode") {
-            string modo; int marcos = 3; int ventana = 5;
+            string modo, token;
             ss >> modo;
-            if (ss.fail()) { cout << "memmode <fifo|lru|ws> [marcos] [ventana]\n"; continue; }
+            PoliticaMemoria politica;
+            if (ss.fail() || !politica_desde_texto(modo, politica)) {
+                cout << "memmode <fifo|lru|ws|clock|sc|aging> [marcos] [ventana] [reiniciar]\n";
+                continue;
+            }
 
-            if (ss >> marcos) { /* opcional numero de marcos */ }
-            if (ss >> ventana) { /* opcional ventana WS */ }
+            // marcos y ventana opcionales: por defecto se mantienen los actuales
+            int marcos = gestor.get_max_marcos(), ventana = gestor.get_ventana(), numeros = 0;
+            bool reiniciar = false, ok = true;
+            while (ss >> token) {
+                if (token == "reiniciar") reiniciar = true;
+                else if (numeros < 2 && !token.empty() && all_of(token.begin(), token.end(), ::isdigit))
+                    (numeros++ == 0 ? marcos : ventana) = stoi(token);
+                else ok = false;
+            }
+            if (!ok || marcos < 1) {
+                cout << "memmode <fifo|lru|ws|clock|sc|aging> [marcos] [ventana] [reiniciar]\n";
+                continue;
+            }
 
-            bool lru = false, ws = false;
-            if (modo == "lru") lru = true;
-            else if (modo == "ws") ws = true;
+            if (reiniciar) {
+                for (GestorMarcos *g : memorias) {
+                    *g = GestorMarcos(marcos, politica, ventana, &traza, &traza_accesos);
+                    g->set_tlb(config_tlb);
+                }
+                traza_accesos.limpiar_anillo(); // la traza completa, si esta abierta, continua
+                cout << "[!] Reiniciado gestor de marcos con " << marcos << " marcos\n";
+            } else {
+                int antes = gestor.get_max_marcos();
+                int expulsadas = gestor.reconfigurar(marcos, politica, ventana);
+                cout << "[!] Gestor de marcos reconfigurado: " << antes << " -> " << marcos << " marcos";
+                if (expulsadas) cout << " (" << expulsadas << " paginas expulsadas)";
+                cout << "; paginas residentes y contadores conservados\n";
+            }
+            if (politica == PoliticaMemoria::WS) cout << "[!] Politica memoria: Working Set (ventana=" << ventana << ")\n";
+            else if (politica == PoliticaMemoria::AGING)
+                cout << "[!] Politica memoria: AGING (envejece cada " << ventana << " accesos)\n";
+            else cout << "[!] Politica memoria: " << nombre_politica(politica) << "\n";
+        }
 
-            gestor = GestorMarcos(marcos, lru, ws, ventana);
-            cout << "[!] Reiniciado gestor de marcos con " << marcos << " marcos\n";
-            if (ws) cout << "[!] Politica memoria: Working Set (ventana=" << ventana << ")\n";
-            else cout << "[!] Politica memoria: " << (lru ? "LRU" : "FIFO") << "\n";
+        // TLB delante de la tabla de paginas
+        else if (cmd == "memtlb") {
+            string token; int numeros = 0; bool ok = true;
+            ConfigTLB c = config_tlb;
+            while (ss >> token) {
+                if (token == "off") c.entradas = 0;
+                else if (token == "lru") c.reemplazo = ReemplazoTLB::LRU;
+                else if (token == "rand") c.reemplazo = ReemplazoTLB::ALEATORIO;
+                else if (token == "flush") c.asid = false;
+                else if (token == "asid") c.asid = true;
+                else if (isdigit((unsigned char)token[0]) && numeros < 2)
+                    (numeros++ == 0 ? c.entradas : c.asociatividad) = atoi(token.c_str());
+                else ok = false;
+            }
+            if (!ok || c.asociatividad < 1) {
+                cout << "Uso: memtlb <entradas> [vias] [lru|rand] [flush|asid] | memtlb off\n";
+                continue;
+            }
+            config_tlb = c;
+            for (GestorMarcos *g : memorias) g->set_tlb(config_tlb);
+            config_tlb = gestor.get_tlb().config(); // entradas ajustadas a multiplo de las vias
+            if (!gestor.get_tlb().activo()) cout << "[!] TLB desactivado\n";
+            else gestor.mostrar_tlb();
         }
 
         // Cena filosofos
         else if (cmd == "filosofos") {
-            int n = 5, rondas = 3;
+            int n = 5, rondas = 3, pausa = 0;
             ss >> n >> rondas;
             if (ss.fail()) {
-                cout << "Uso: filosofos [num_filosofos] [rondas]\n";
+                cout << "Uso: filosofos [num_filosofos] [rondas] [pausa_ms]\n";
+                continue;
+            }
+            if (!(ss >> pausa) || pausa < 0) pausa = 0;
+            simular_cena_filosofos(n, rondas, &traza, pausa);
+        }
+        else if (cmd == "cena") {
+            string est = "todas";
+            ParametrosCena par;
+            ss >> est;
+            if (!(ss >> par.filosofos)) par.filosofos = 5;
+            if (!(ss >> par.comidas)) par.comidas = 1000;
+            if (!(ss >> par.pensar_us)) par.pensar_us = 0;
+            if (!(ss >> par.comer_us)) par.comer_us = 0;
+            bool todas = est == "todas";
+            if ((!todas && !estrategia_cena_desde_texto(est, par.estrategia)) || par.filosofos < 2 ||
+                par.filosofos > 10000 || par.comidas < 1 || par.pensar_us < 0 || par.comer_us < 0) {
+                cout << "Uso: cena <ingenua|orden|camarero|chandy|todas> [filosofos 2-10000] [comidas] "
+                        "[pensar_us] [comer_us]\n";
                 continue;
             }
-            simular_cena_filosofos(n, rondas);
+            vector<EstrategiaCena> ests = todas ? vector<EstrategiaCena>{EstrategiaCena::INGENUA, EstrategiaCena::ORDEN,
+                                                                         EstrategiaCena::CAMARERO,
+                                                                         EstrategiaCena::CHANDY_MISRA}
+                                                : vector<EstrategiaCena>{par.estrategia};
+            vector<pair<EstrategiaCena, ResultadoCena>> res;
+            for (auto e : ests) {
+                par.estrategia = e;
+                res.push_back({e, ejecutar_cena_hilos(par)});
+            }
+            mostrar_resultados_cena(par, res);
         }
 
         // Impresora
@@ -1184,12 +649,9 @@ int main() {
             // Eliminar espacios iniciales en el contenido
             contenido.erase(0, contenido.find_first_not_of(" \t"));
 
-            shared_ptr<Proceso> p = planificador_rr.obtener_proceso(pid);
-            if (!p)
-                p = planificador_sjf.obtener_proceso(pid);
-
-            if (!p) {
-                cout << "[!] No existe proceso con PID " << pid << "\n";
+            HandleProceso p = buscar_proceso(pid);
+            if (!p || p.estado() == EstadoProceso::TERMINADO) {
+                cout << "[!] No existe proceso activo con PID " << pid << "\n";
                 continue;
             }
 
@@ -1197,7 +659,17 @@ int main() {
         }
 
         else if (cmd == "printproc") {
-            impresora.procesar_impresion();
+            int ticks = 0;
+            if (!(ss >> ticks)) ticks = 0;
+            int n = impresora.procesar_impresion(ticks);
+            if (ticks > 0) cout << "[IMPRESORA] " << ticks << " ticks, " << n << " trabajos terminados\n";
+        }
+        else if (cmd == "printlote") {
+            int n;
+            ss >> n;
+            if (ss.fail() || n < 1) { cout << "Uso: printlote <trabajos por lote>\n"; continue; }
+            impresora.set_lote(n);
+            cout << "[IMPRESORA] Lotes de hasta " << n << " trabajos\n";
         }
 
         else if (cmd == "printstat") {
@@ -1213,7 +685,7 @@ int main() {
 
             vector<int> reqs = {55, 58, 60, 70, 18, 90, 150, 38, 184};
             int pos_inicial = 50;
-            SimuladorDisco disco(reqs, pos_inicial);
+            SimuladorDisco disco(reqs, pos_inicial, &traza);
 
             if (algoritmo == "fcfs") disco.ejecutar_FCFS();
             else if (algoritmo == "sstf") disco.ejecutar_SSTF();
@@ -1229,7 +701,50 @@ int main() {
 
         // Estadisticas memoria
         else if (cmd == "memstat") gestor.mostrar_estado();
-        else if (cmd == "memtrace") gestor.mostrar_trazas();
+        else if (cmd == "memtrace") {
+            string arg; ss >> arg;
+            if (arg.empty()) gestor.mostrar_trazas();
+            else if (isdigit((unsigned char)arg[0])) gestor.mostrar_trazas(atoi(arg.c_str()));
+            else if (arg == "on" || arg == "off") traza_accesos.set_activo(arg == "on");
+            else if (arg == "archivo") {
+                string ruta; ss >> ruta;
+                if (ruta.empty() || ruta == "off") traza_accesos.cerrar_archivo();
+                else if (!traza_accesos.abrir_archivo(ruta)) { cout << "[!] No se pudo abrir " << ruta << "\n"; continue; }
+            }
+            else {
+                cout << "Uso: memtrace [n] | memtrace <on|off> | memtrace archivo <ruta|off>\n";
+                continue;
+            }
+            if (!arg.empty() && !isdigit((unsigned char)arg[0])) traza_accesos.mostrar_estado();
+        }
+        else if (cmd == "memcurva") {
+            // curva de fallos de los accesos registrados por el gestor o de la carga de la sesion
+            string token; int max_marcos = 0; bool carga = false, opt = false, ok = true;
+            while (ss >> token) {
+                if (token == "carga") carga = true;
+                else if (token == "opt") opt = true;
+                else if (isdigit((unsigned char)token[0])) max_marcos = atoi(token.c_str());
+                else ok = false;
+            }
+            if (!ok) { cout << "Uso: memcurva [carga] [max_marcos] [opt]\n"; continue; }
+            vector<uint64_t> refs;
+            if (carga) {
+                refs.reserve(carga_sesion.accesos.size());
+                for (auto &[pid, pag] : carga_sesion.accesos) refs.push_back(((uint64_t)(uint32_t)pid << 32) | (uint32_t)pag);
+            } else {
+                refs = gestor.referencias_registradas();
+                if (!traza_accesos.archivo_activo() && traza_accesos.anillo_truncado())
+                    cout << "[!] Solo se analizan los ultimos " << refs.size()
+                         << " accesos (anillo); use 'memtrace archivo <ruta>' para la traza completa\n";
+            }
+            if (refs.empty()) { cout << "[!] No hay accesos para analizar\n"; continue; }
+            imprimir_curva_fallos(calcular_curva_fallos(refs, max_marcos, opt, pool));
+        }
+        else if (cmd == "memstats") {
+            int pid; ss >> pid;
+            if (ss.fail()) { cout << "memstats <pid>\n"; continue; }
+            gestor.mostrar_estadisticas_proceso(pid);
+        }
         else if (cmd == "memview") {
             gestor.visualizar_memoria_ascii();
         }
@@ -1240,6 +755,118 @@ int main() {
         }
         else if (cmd == "consume") sync_sim.consumir_simulado();
         else if (cmd == "bufstat") sync_sim.estado_buffer();
+        else if (cmd == "sem_wait" || cmd == "sem_signal") {
+            string nombre;
+            ss >> nombre;
+            SemaforoSimulado *sem = buscar_semaforo(nombre);
+            if (!sem) {
+                cout << "Uso: " << cmd << " <nombre>" << (cmd == "sem_wait" ? " <pid>" : "") << "  (semaforos:";
+                for (auto &kv : semaforos) cout << " " << kv.first;
+                cout << ")\n";
+                continue;
+            }
+            if (cmd == "sem_signal") {
+                HandleProceso p = sem->signal();
+                if (!p) {
+                    cout << "[SEM] " << nombre << " = " << sem->get_valor() << "\n";
+                    continue;
+                }
+                // el proceso despertado vuelve a la cola de listos de su planificador
+                reencolar(p);
+                cout << "[SEM] " << nombre << ": despierta al proceso " << p.pid << "\n";
+                continue;
+            }
+            int pid;
+            ss >> pid;
+            if (ss.fail()) {
+                cout << "Uso: sem_wait <nombre> <pid>\n";
+                continue;
+            }
+            HandleProceso p = buscar_proceso(pid);
+            if (!p) {
+                cout << "[!] No existe proceso con PID " << pid << "\n";
+                continue;
+            }
+            if (p.estado() == EstadoProceso::BLOQUEADO || p.estado() == EstadoProceso::TERMINADO) {
+                cout << "[!] El proceso " << pid << " esta " << nombre_estado(p.estado()) << "\n";
+                continue;
+            }
+            if (!sem->wait(p))
+                cout << "[SEM] " << nombre << ": proceso " << pid << " BLOQUEADO (" << sem->bloqueados() << " en cola)\n";
+            else
+                cout << "[SEM] " << nombre << " = " << sem->get_valor() << " (proceso " << pid << " continua)\n";
+        }
+        else if (cmd == "semstat") {
+            vector<pair<string, const SemaforoSimulado *>> vista(semaforos.begin(), semaforos.end());
+            vista.push_back({"imp_vacio", &impresora.semaforo_vacio()});
+            vista.push_back({"imp_ocupado", &impresora.semaforo_ocupado()});
+            mostrar_semaforos(vista);
+        }
+        else if (cmd == "pchilos") {
+            string tipo = "todos";
+            ParametrosPC par;
+            long long capacidad = (long long)par.capacidad;
+            ss >> tipo;
+            if (!(ss >> par.productores)) par.productores = 2;
+            if (!(ss >> par.consumidores)) par.consumidores = par.productores;
+            if (!(ss >> capacidad)) capacidad = 1024;
+            if (!(ss >> par.items)) par.items = 1000000;
+            bool todos = tipo == "todos";
+            if ((!todos && !buffer_pc_desde_texto(tipo, par.tipo)) || par.productores < 1 || par.productores > 256 ||
+                par.consumidores < 1 || par.consumidores > 256 || capacidad < 1 || capacidad > (1 << 24) ||
+                par.items < 1 || par.items > 1000000000LL) {
+                cout << "Uso: pchilos <spsc|mpmc|mutex|todos> [productores 1-256] [consumidores 1-256] "
+                        "[capacidad 1-16777216] [items]\n";
+                continue;
+            }
+            par.capacidad = (size_t)capacidad;
+            vector<TipoBufferPC> tipos = todos ? vector<TipoBufferPC>{TipoBufferPC::SPSC, TipoBufferPC::MPMC,
+                                                                      TipoBufferPC::MUTEX}
+                                               : vector<TipoBufferPC>{par.tipo};
+            vector<pair<TipoBufferPC, ResultadoPC>> res;
+            for (auto t : tipos) {
+                if (t == TipoBufferPC::SPSC && par.productores != par.consumidores) {
+                    cout << "[!] SPSC usa un anillo por pareja: requiere productores == consumidores\n";
+                    continue;
+                }
+                par.tipo = t;
+                res.push_back({t, ejecutar_productor_consumidor(par)});
+            }
+            if (!res.empty()) mostrar_resultados_pc(par, res);
+        }
+        // Registro de eventos
+        else if (cmd == "log") {
+            string arg; ss >> arg;
+            if (arg == "off") traza.set_nivel(NivelTraza::OFF);
+            else if (arg == "resumen") traza.set_nivel(NivelTraza::RESUMEN);
+            else if (arg == "eventos") traza.set_nivel(NivelTraza::EVENTOS);
+            else if (arg == "ticks") traza.set_nivel(NivelTraza::TICKS);
+            else if (arg == "consola") {
+                string on; ss >> on;
+                traza.set_eco_consola(on != "off");
+            }
+            else if (arg == "archivo") {
+                string ruta; ss >> ruta;
+                if (ruta.empty() || ruta == "off") traza.cerrar_archivo();
+                else if (!traza.abrir_archivo(ruta)) { cout << "[!] No se pudo abrir " << ruta << "\n"; continue; }
+            }
+            else if (arg == "ultimos") {
+                size_t n = 20; ss >> n;
+                traza.mostrar_ultimos(n);
+                continue;
+            }
+            else if (!arg.empty()) {
+                cout << "Uso: log [off|resumen|eventos|ticks] | log consola <on|off> | log archivo <ruta|off> | log ultimos [n]\n";
+                continue;
+            }
+            traza.mostrar_estado();
+        }
+        else if (cmd == "benchsjf") {
+            int n = 1000000;
+            ss >> n;
+            if (ss.fail() || n <= 0) n = 1000000;
+            benchmark_sjf(n);
+        }
         else if (cmd == "exit") {
             cout << "Saliendo...\n";
             break;
@@ -1266,7 +893,7 @@ int main() {
                 continue;
             }
 
-            SimuladorDisco sim(reqs, pos_inicial);
+            SimuladorDisco sim(reqs, pos_inicial, &traza);
 
             if (tipo == "fcfs") sim.ejecutar_FCFS();
             else if (tipo == "sstf") sim.ejecutar_SSTF();
@@ -0,0 +1,1350 @@
+#include "simulador.h"
+using namespace std;
+
+
+// ------------------------- Tabla de procesos -------------------------
+const char *nombre_estado(EstadoProceso e) {
+    switch (e) {
+        case EstadoProceso::LISTO:      return "LISTO";
+        case EstadoProceso::EJECUTANDO: return "EJECUTANDO";
+        case EstadoProceso::BLOQUEADO:  return "BLOQUEADO";
+        case EstadoProceso::TERMINADO:  return "TERMINADO";
+        case EstadoProceso::SUSPENDIDO: return "SUSPENDIDO";
+    }
+    return "?";
+}
+
+
+// ------------------------- Politicas de memoria -------------------------
+const char *nombre_politica(PoliticaMemoria p) {
+    switch (p) {
+        case PoliticaMemoria::FIFO:                return "FIFO";
+        case PoliticaMemoria::LRU:                 return "LRU";
+        case PoliticaMemoria::WS:                  return "WS";
+        case PoliticaMemoria::CLOCK:               return "CLOCK";
+        case PoliticaMemoria::SEGUNDA_OPORTUNIDAD: return "SC";
+        case PoliticaMemoria::AGING:               return "AGING";
+    }
+    return "?";
+}
+
+bool politica_desde_texto(const string &s, PoliticaMemoria &p) {
+    if (s == "fifo") p = PoliticaMemoria::FIFO;
+    else if (s == "lru") p = PoliticaMemoria::LRU;
+    else if (s == "ws") p = PoliticaMemoria::WS;
+    else if (s == "clock") p = PoliticaMemoria::CLOCK;
+    else if (s == "sc") p = PoliticaMemoria::SEGUNDA_OPORTUNIDAD;
+    else if (s == "aging") p = PoliticaMemoria::AGING;
+    else return false;
+    return true;
+}
+
+
+// ------------------------- Traza de accesos a memoria -------------------------
+void TrazaAccesos::agregar_columnas(const AccesoRegistro &r) {
+    if (r.pid >= (int)dic_indice.size()) {
+        dic_indice.resize(r.pid + 1);
+        dic_bloque.resize(r.pid + 1, UINT32_MAX);
+    }
+    uint32_t bloque = (uint32_t)bloques_archivo;
+    if (dic_bloque[r.pid] != bloque) {
+        dic_bloque[r.pid] = bloque;
+        dic_indice[r.pid] = (uint32_t)pagina_anterior.size();
+        pagina_anterior.push_back(0);
+        poner_varint(col_dic, (uint32_t)r.pid);
+    }
+    uint32_t idx = dic_indice[r.pid];
+    poner_varint(col_tick, zigzag((int64_t)r.tick - tick_anterior));
+    poner_varint(col_pid, idx);
+    poner_varint(col_pagina, zigzag((int64_t)r.pagina - pagina_anterior[idx]));
+    poner_varint(col_resultado,
+                 ((uint64_t)(uint32_t)r.tiempo_acceso_simulado << 2) | (r.escritura ? 2 : 0) | (r.hit ? 1 : 0));
+    tick_anterior = r.tick;
+    pagina_anterior[idx] = r.pagina;
+    if (++en_bloque == ACCESOS_POR_BLOQUE) volcar_bloque();
+}
+
+// Escribe en el archivo a traves de un mapeo temporal de solo la zona tocada: la memoria
+// del proceso no crece con el largo de la traza y el SO vuelca las paginas en segundo plano.
+void TrazaAccesos::escribir_archivo(uint64_t offset, const void *datos, size_t n) {
+    if (n == 0) return;
+    static const uint64_t PAGINA = (uint64_t)sysconf(_SC_PAGESIZE);
+    uint64_t base = offset & ~(PAGINA - 1);
+    if (offset + n > bytes_archivo && ftruncate(fd, (off_t)(offset + n)) != 0) return;
+    void *p = mmap(nullptr, offset + n - base, PROT_WRITE, MAP_SHARED, fd, (off_t)base);
+    if (p == MAP_FAILED) return;
+    memcpy((uint8_t *)p + (offset - base), datos, n);
+    munmap(p, offset + n - base);
+}
+
+void TrazaAccesos::volcar_bloque() {
+    if (en_bloque == 0) return;
+    CabeceraBloqueAccesos cab{en_bloque, (uint32_t)pagina_anterior.size(),
+                              {(uint32_t)col_dic.size(), (uint32_t)col_tick.size(), (uint32_t)col_pid.size(),
+                               (uint32_t)col_pagina.size(), (uint32_t)col_resultado.size()}};
+    uint64_t offset = bytes_archivo;
+    escribir_archivo(offset, &cab, sizeof(cab));
+    offset += sizeof(cab);
+    for (auto *col : {&col_dic, &col_tick, &col_pid, &col_pagina, &col_resultado}) {
+        escribir_archivo(offset, col->data(), col->size());
+        offset += col->size();
+        col->clear(); // conserva la capacidad: el siguiente bloque no vuelve a reservar
+    }
+    bytes_archivo = offset;
+    accesos_archivo += en_bloque;
+    bloques_archivo++;
+    en_bloque = 0;
+    tick_anterior = 0;
+    pagina_anterior.clear();
+    CabeceraTrazaAccesos cab_archivo{{'S', 'O', 'T', 'A'}, 1, accesos_archivo, bloques_archivo};
+    escribir_archivo(0, &cab_archivo, sizeof(cab_archivo));
+}
+
+bool TrazaAccesos::abrir_archivo(const string &ruta) {
+    cerrar_archivo();
+    fd = open(ruta.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    ruta_archivo = ruta;
+    accesos_archivo = bloques_archivo = 0;
+    bytes_archivo = 0;
+    en_bloque = 0;
+    tick_anterior = 0;
+    pagina_anterior.clear();
+    dic_bloque.assign(dic_bloque.size(), UINT32_MAX);
+    CabeceraTrazaAccesos cab{{'S', 'O', 'T', 'A'}, 1, 0, 0};
+    escribir_archivo(0, &cab, sizeof(cab));
+    bytes_archivo = sizeof(cab);
+    return true;
+}
+
+void TrazaAccesos::cerrar_archivo() {
+    if (fd < 0) return;
+    volcar_bloque();
+    close(fd);
+    fd = -1;
+    // las columnas del bloque en curso no se necesitan hasta la proxima apertura
+    for (auto *col : {&col_dic, &col_tick, &col_pid, &col_pagina, &col_resultado}) vector<uint8_t>().swap(*col);
+}
+
+void TrazaAccesos::mostrar_estado() const {
+    cout << "[MEMTRACE] Registro " << (activo ? "activo" : "apagado") << " | Anillo: " << en_anillo() << "/"
+         << CAPACIDAD_ANILLO << " accesos";
+    if (!ruta_archivo.empty()) {
+        cout << " | Archivo" << (fd >= 0 ? ": " : " (cerrado): ") << ruta_archivo << " (" << get_accesos_archivo()
+             << " accesos, " << bytes_archivo << " bytes";
+        if (accesos_archivo > 0)
+            cout << ", " << fixed << setprecision(2) << (double)bytes_archivo / accesos_archivo << " bytes/acceso";
+        cout << ")";
+    }
+    cout << "\n";
+}
+
+vector<uint64_t> TrazaAccesos::referencias() {
+    vector<uint64_t> r;
+    if (fd >= 0) {
+        volcar_bloque(); // el bloque parcial pasa al archivo para leerlo completo
+        r.reserve(accesos_archivo);
+        if (leer_referencias(ruta_archivo, r)) return r;
+        r.clear();
+    }
+    size_t n = en_anillo();
+    r.reserve(n);
+    for (size_t i = n; i-- > 0;) {
+        const AccesoRegistro &a = reciente(i);
+        r.push_back(((uint64_t)(uint32_t)a.pid << 32) | (uint32_t)a.pagina);
+    }
+    return r;
+}
+
+// Lote de accesos decodificados: columnas del tamaño de un bloque, reutilizadas entre bloques
+struct LoteAccesos {
+    vector<uint32_t> pid, pagina;
+    vector<uint8_t> escritura;
+    size_t n = 0;
+};
+
+// Decodifica la traza columnar bloque a bloque y llama a 'por_bloque(lote)' con cada uno
+template <class F>
+static bool recorrer_traza_accesos(const ArchivoMapeado &m, F &&por_bloque) {
+    if (m.tam() < sizeof(CabeceraTrazaAccesos)) return false;
+    const uint8_t *p = m.datos(), *fin = p + m.tam();
+    CabeceraTrazaAccesos cab;
+    memcpy(&cab, p, sizeof(cab));
+    if (memcmp(cab.magia, "SOTA", 4) != 0 || cab.version != 1) return false;
+    p += sizeof(cab);
+    vector<uint32_t> dic;
+    vector<uint32_t> pagina;
+    LoteAccesos lote;
+    for (uint64_t b = 0; b < cab.n_bloques; ++b) {
+        CabeceraBloqueAccesos cb;
+        if ((size_t)(fin - p) < sizeof(cb)) return false;
+        memcpy(&cb, p, sizeof(cb));
+        p += sizeof(cb);
+        // cada columna [col[k], col[k + 1]) tiene que caber en lo que queda del archivo
+        const uint8_t *col[6];
+        col[0] = p;
+        for (int k = 0; k < 5; ++k) {
+            if ((size_t)(fin - col[k]) < cb.bytes[k]) return false;
+            col[k + 1] = col[k] + cb.bytes[k];
+        }
+        // cada varint ocupa al menos un byte: acota los tamaños antes de reservar
+        if (cb.n_pids > cb.bytes[0] || cb.n_accesos > cb.bytes[2] || cb.n_accesos > cb.bytes[3]
+            || cb.n_accesos > cb.bytes[4])
+            return false;
+        const uint8_t *d = col[0], *c_pid = col[2], *c_pag = col[3], *c_res = col[4];
+        uint64_t v, dp, r;
+        dic.resize(cb.n_pids);
+        for (auto &x : dic) {
+            if (!leer_varint(d, col[1], v)) return false;
+            x = (uint32_t)v;
+        }
+        pagina.assign(cb.n_pids, 0);
+        lote.pid.resize(cb.n_accesos);
+        lote.pagina.resize(cb.n_accesos);
+        lote.escritura.resize(cb.n_accesos);
+        // los ticks no hacen falta para reproducir la secuencia
+        for (uint32_t i = 0; i < cb.n_accesos; ++i) {
+            if (!leer_varint(c_pid, col[3], v) || !leer_varint(c_pag, col[4], dp) || !leer_varint(c_res, col[5], r))
+                return false;
+            if (v >= cb.n_pids) return false;
+            uint32_t idx = (uint32_t)v;
+            pagina[idx] += (uint32_t)deszigzag(dp); // aritmetica sin signo: un delta corrupto no desborda
+            lote.pid[i] = dic[idx];
+            lote.pagina[i] = pagina[idx];
+            lote.escritura[i] = (uint8_t)((r >> 1) & 1);
+        }
+        lote.n = cb.n_accesos;
+        por_bloque(lote);
+        p = col[5];
+    }
+    return true;
+}
+
+bool TrazaAccesos::leer_referencias(const string &ruta, vector<uint64_t> &out) {
+    ArchivoMapeado m;
+    if (!m.abrir(ruta)) return false;
+    return recorrer_traza_accesos(m, [&](const LoteAccesos &l) {
+        for (size_t i = 0; i < l.n; ++i) out.push_back(((uint64_t)l.pid[i] << 32) | l.pagina[i]);
+    });
+}
+
+
+// ------------------------- Metricas por nucleo -------------------------
+ResumenPlanificador calcular_resumen(const TablaProcesos &tabla, const vector<MetricasNucleo> &nucleos,
+                                     int tiempo_actual, long long capacidad) {
+    ResumenPlanificador r;
+    double espera_total = 0;
+    double retorno_total = 0;
+    long long cpu_ticks_ocupados = 0;
+    for (int pid = 1; pid <= tabla.cantidad(); ++pid) {
+        if (tabla.tiempo_finalizacion[pid] != -1) {
+            int turnaround = tabla.tiempo_finalizacion[pid] - tabla.tiempo_llegada[pid];
+            int waiting = turnaround - tabla.tiempo_requerido[pid];
+            espera_total += waiting;
+            retorno_total += turnaround;
+            r.finalizados++;
+        }
+    }
+    for (auto &m : nucleos) {
+        cpu_ticks_ocupados += m.ticks_ocupados;
+        r.despachos += m.despachos;
+        r.migraciones += m.migraciones;
+    }
+    if (r.finalizados > 0) {
+        r.espera_promedio = espera_total / r.finalizados;
+        r.retorno_promedio = retorno_total / r.finalizados;
+    }
+    r.makespan = tiempo_actual;
+    r.utilizacion = (capacidad>0 ? (double)cpu_ticks_ocupados / capacidad : 0.0);
+    return r;
+}
+
+
+void imprimir_estadisticas(const TablaProcesos &tabla, const vector<MetricasNucleo> &nucleos, int activos,
+                           int tiempo_actual, long long capacidad) {
+    ResumenPlanificador r = calcular_resumen(tabla, nucleos, tiempo_actual, capacidad);
+    long long cpu_ticks_ocupados = 0;
+    int makespan = tiempo_actual;
+    for (auto &m : nucleos) cpu_ticks_ocupados += m.ticks_ocupados;
+    cout << fixed << setprecision(3);
+    if (r.finalizados == 0) cout << "Aun no hay procesos finalizados.\n";
+    else {
+        cout << "Promedio espera: " << r.espera_promedio
+             << " | Promedio turnaround: " << r.retorno_promedio << "\n";
+    }
+    cout << "Tiempo actual (makespan sim): " << tiempo_actual << " | CPU utilisation (sim): " << r.utilizacion << "\n";
+
+    int mostrados = 0;
+    for (int k = 0; k < (int)nucleos.size(); ++k)
+        if (k < activos || nucleos[k].despachos > 0) mostrados++;
+    if (mostrados <= 1) return;
+    cout << "\nCPU\tUtil\tDesp\tMigr\tTerm\tEspera\tTurnaround\n";
+    long long max_ocupados = 0;
+    for (int k = 0; k < (int)nucleos.size(); ++k) {
+        const auto &m = nucleos[k];
+        if (k >= activos && m.despachos == 0) continue;
+        max_ocupados = max(max_ocupados, m.ticks_ocupados);
+        cout << k << "\t" << (makespan > 0 ? (double)m.ticks_ocupados / makespan : 0.0)
+             << "\t" << m.despachos << "\t" << m.migraciones << "\t" << m.terminados << "\t"
+             << (m.terminados ? (double)m.espera_terminados / m.terminados : 0.0) << "\t"
+             << (m.terminados ? (double)m.retorno_terminados / m.terminados : 0.0) << "\n";
+    }
+    double promedio = (double)cpu_ticks_ocupados / mostrados;
+    cout << "Desbalance de carga (max/prom - 1): " << (promedio > 0 ? max_ocupados / promedio - 1.0 : 0.0)
+         << " | Migraciones: " << r.migraciones << "\n";
+}
+
+
+// ------------------------- Benchmark SJF (sort vs heap) -------------------------
+void benchmark_sjf(int n, int despachos_antiguo) {
+    using reloj = chrono::steady_clock;
+    mt19937 rng(42);
+    uniform_int_distribution<int> rafaga(1, 1000000);
+    TablaProcesos tabla;
+    tabla.reservar(n);
+    for (int i = 0; i < n; ++i) tabla.crear(rafaga(rng), 0);
+
+    cout << "\n[BENCH] SJF con " << n << " trabajos en cola\n";
+
+    // Antiguo: cada despacho limpia terminados, ordena todo el vector y borra el frente
+    vector<int> cola(n);
+    for (int i = 0; i < n; ++i) cola[i] = i + 1;
+    int k = min(n, despachos_antiguo);
+    long long suma_antiguo = 0;
+    auto t0 = reloj::now();
+    for (int i = 0; i < k; ++i) {
+        cola.erase(remove_if(cola.begin(), cola.end(),
+            [&](int p){ return tabla.estado[p] == EstadoProceso::TERMINADO; }), cola.end());
+        sort(cola.begin(), cola.end(),
+             [&](int a, int b){ return tabla.tiempo_restante[a] < tabla.tiempo_restante[b]; });
+        suma_antiguo += tabla.tiempo_restante[cola.front()];
+        cola.erase(cola.begin());
+    }
+    double ns_antiguo = chrono::duration<double, nano>(reloj::now() - t0).count() / max(1, k);
+
+    // Nuevo: heap indexado, se miden la carga y todos los despachos
+    HeapSJF heap(&tabla);
+    heap.reservar(n);
+    auto t1 = reloj::now();
+    for (int pid = 1; pid <= n; ++pid) heap.push(pid);
+    auto t2 = reloj::now();
+    long long suma_nuevo = 0;
+    for (int i = 0; i < n; ++i) {
+        int p = heap.pop();
+        if (i < k) suma_nuevo += tabla.tiempo_restante[p];
+    }
+    auto t3 = reloj::now();
+    double ms_carga = chrono::duration<double, milli>(t2 - t1).count();
+    double ns_nuevo = chrono::duration<double, nano>(t3 - t2).count() / max(1, n);
+
+    cout << fixed << setprecision(3);
+    cout << "  Antiguo (sort + erase): " << ns_antiguo / 1e6 << " ms/despacho (" << k
+         << " medidos) -> " << ns_antiguo * n / 1e9 << " s estimados para vaciar la cola\n";
+    cout << "  Heap indexado:          " << ns_nuevo / 1e3 << " us/despacho (" << n
+         << " medidos) + carga " << ms_carga << " ms -> " << (ns_nuevo * n / 1e6 + ms_carga) << " ms en total\n";
+    cout << "  Aceleracion por despacho: " << (ns_nuevo > 0 ? ns_antiguo / ns_nuevo : 0.0) << "x\n";
+    cout << "  Orden de despacho " << (suma_antiguo == suma_nuevo ? "coincide" : "NO coincide")
+         << " en los primeros " << k << " despachos\n";
+}
+
+
+// ------------------------- Dispositivos -------------------------
+const char *nombre_tipo_dispositivo(TipoDispositivo t) {
+    switch (t) {
+        case TipoDispositivo::DISCO: return "disco";
+        case TipoDispositivo::RED:   return "red";
+        case TipoDispositivo::USB:   return "usb";
+        case TipoDispositivo::OTRO:  return "otro";
+    }
+    return "?";
+}
+
+bool tipo_dispositivo_desde_texto(const string &s, TipoDispositivo &t) {
+    if (s == "disco") t = TipoDispositivo::DISCO;
+    else if (s == "red") t = TipoDispositivo::RED;
+    else if (s == "usb") t = TipoDispositivo::USB;
+    else if (s == "otro") t = TipoDispositivo::OTRO;
+    else return false;
+    return true;
+}
+
+void DispositivoSimulado::estado(int ahora) const {
+    const HistogramaLatencia &l = latencias;
+    cout << left << setw(14) << nombre << setw(7) << nombre_tipo_dispositivo(tipo) << setw(8)
+         << (en_ejecucion ? "OCUPADO" : "LIBRE") << right << setw(9) << cola.size() << setw(9) << cola_max
+         << fixed << setprecision(2) << setw(10) << cola_media(ahora) << setprecision(1) << setw(8)
+         << 100.0 * utilizacion(ahora) << setw(11) << atendidas << setw(8) << l.percentil(0.50) << setw(8)
+         << l.percentil(0.99) << setw(8) << l.maximo << "\n";
+}
+
+static void cabecera_dispositivos() {
+    cout << left << setw(14) << "Dispositivo" << setw(7) << "tipo" << setw(8) << "estado" << right << setw(9)
+         << "cola" << setw(9) << "cola max" << setw(10) << "cola med" << setw(8) << "util%" << setw(11)
+         << "atendidas" << setw(8) << "p50" << setw(8) << "p99" << setw(8) << "max" << "\n";
+}
+
+void GestorDispositivos::estado(size_t filas) const {
+    cout << "\n=== Estado de dispositivos (t=" << tiempo << ", " << dispositivos.size() << " dispositivos, "
+         << en_espera << " solicitudes pendientes, " << rueda.programados() << " en la rueda) ===\n";
+    cabecera_dispositivos();
+    vector<int> orden(dispositivos.size());
+    for (size_t d = 0; d < orden.size(); ++d) orden[d] = (int)d;
+    if (orden.size() > filas) {
+        partial_sort(orden.begin(), orden.begin() + filas, orden.end(), [&](int a, int b) {
+            double ua = dispositivos[a].utilizacion(tiempo), ub = dispositivos[b].utilizacion(tiempo);
+            return ua != ub ? ua > ub : a < b;
+        });
+        orden.resize(filas);
+    }
+    for (int d : orden) dispositivos[d].estado(tiempo);
+    if (dispositivos.size() > filas)
+        cout << "  (los " << filas << " de mayor utilizacion; iostat <nombre> para uno en particular)\n";
+
+    // resumen por tipo: utilizacion media y latencias de todas sus solicitudes
+    cout << "Por tipo (latencia en ticks desde la solicitud hasta el fin):\n";
+    for (TipoDispositivo t : {TipoDispositivo::DISCO, TipoDispositivo::RED, TipoDispositivo::USB, TipoDispositivo::OTRO}) {
+        HistogramaLatencia h;
+        double util = 0;
+        size_t n = 0, cola = 0;
+        for (auto &dev : dispositivos) {
+            if (dev.get_tipo() != t) continue;
+            n++;
+            util += dev.utilizacion(tiempo);
+            cola += dev.en_cola();
+            h.sumar(dev.get_latencias());
+        }
+        if (!n) continue;
+        cout << "  " << left << setw(6) << nombre_tipo_dispositivo(t) << right << setw(7) << n << " disp." << fixed
+             << setprecision(1) << "  util " << setw(5) << 100.0 * util / n << "%  en cola " << cola
+             << "  atendidas " << h.n << "  latencia media " << h.media() << "  p50 " << h.percentil(0.50)
+             << "  p99 " << h.percentil(0.99) << "  p999 " << h.percentil(0.999) << "  max " << h.maximo << "\n";
+    }
+}
+
+void GestorDispositivos::estado(const string &nombre) const {
+    int d = buscar(nombre);
+    if (d < 0) {
+        cout << "[!] Dispositivo '" << nombre << "' no existe\n";
+        return;
+    }
+    cout << "\n[IO] Dispositivo " << nombre << " (handle " << d << ", t=" << tiempo << ")\n";
+    cabecera_dispositivos();
+    dispositivos[d].estado(tiempo);
+    const HistogramaLatencia &l = dispositivos[d].get_latencias();
+    if (l.n)
+        cout << fixed << setprecision(1) << "  latencia media " << l.media() << ", p90 " << l.percentil(0.90)
+             << ", p999 " << l.percentil(0.999) << " ticks\n";
+}
+
+
+// ------------------------- Impresora Simulada -------------------------
+void ImpresoraSimulada::estado() const {
+    lock_guard<mutex> lock(mtx);
+    cout << "\n[IMPRESORA] Estado actual (t=" << reloj << ", lotes de hasta " << lote_max << "):\n";
+    cout << " Trabajos en cola: " << cola_impresion.size() << " / " << capacidad << "\n";
+    for (auto &t : cola_impresion)
+        cout << "  PID " << t.proceso.pid << " -> \"" << t.contenido << "\" (" << t.servicio << " ticks)\n";
+    if (!lote.empty())
+        cout << " Imprimiendo: PID " << lote.front().proceso.pid << " (restan " << restante << " ticks), "
+             << lote.size() - 1 << " mas en el lote\n";
+    if (!esperando_lugar.empty()) {
+        cout << " Bloqueados esperando lugar:";
+        for (auto &t : esperando_lugar) cout << " " << t.proceso.pid;
+        cout << "\n";
+    }
+    if (reloj == 0) return;
+
+    double media = 0;
+    for (size_t k = 0; k < ticks_por_ocupacion.size(); ++k) media += (double)k * ticks_por_ocupacion[k];
+    cout << fixed << setprecision(2) << " Lotes: " << lotes << ", impresos: " << impresos << ", ocupada "
+         << 100.0 * ticks_ocupada / reloj << "% del tiempo, cola media " << media / reloj << "\n";
+    cout << " Ticks por ocupacion de la cola:";
+    for (size_t k = 0; k < ticks_por_ocupacion.size(); ++k) cout << " " << k << ":" << ticks_por_ocupacion[k];
+    cout << "\n Ultimos " << linea_ocupacion.size() << " ticks: ";
+    for (uint8_t k : linea_ocupacion) cout << (k < 10 ? (char)('0' + k) : '+');
+    cout << "\n";
+    if (latencias.empty()) return;
+    cout << " Latencia por PID (ticks desde el pedido hasta el fin):\n";
+    cout << "  PID   trabajos     media       max\n";
+    for (auto &[pid, l] : latencias)
+        cout << "  " << left << setw(6) << pid << right << setw(8) << l.trabajos << setprecision(1) << setw(10)
+             << (double)l.total / l.trabajos << setw(10) << l.max << "\n";
+}
+
+
+// ------------------------- Semaforos -------------------------
+void mostrar_semaforos(const vector<pair<string, const SemaforoSimulado *>> &sems) {
+    cout << "\n=== Semaforos ===\n";
+    cout << left << setw(14) << "Nombre" << right << setw(7) << "valor" << setw(10) << "esperas" << setw(10) << "bloqueos"
+         << setw(10) << "signals" << setw(12) << "despertados" << setw(10) << "max cola" << setw(10) << "en cola"
+         << setw(16) << "bloq. total us" << setw(14) << "bloq. max us" << "\n";
+    for (auto &[nombre, s] : sems) {
+        MetricasSemaforo m = s->metricas();
+        cout << left << setw(14) << nombre << right << setw(7) << s->get_valor() << setw(10) << m.esperas
+             << setw(10) << m.bloqueos << setw(10) << m.signals << setw(12) << m.despertados << setw(10) << m.max_cola
+             << setw(10) << s->bloqueados() << fixed << setprecision(1) << setw(16) << m.bloqueado_total_us
+             << setw(14) << m.bloqueado_max_us << "\n";
+    }
+}
+
+
+// ------------------------- Simulacion de la cena -------------------------
+void simular_cena_filosofos(int N, int rondas, RegistroEventos *traza, int pausa_ms) {
+    cout << "\n=== Simulacion: Cena de los Filosofos ===\n";
+
+    vector<SemaforoSimulado> tenedores(N);
+    TablaProcesos procesos;
+    vector<FilosofoSimulado> filosofos;
+
+    // Crear filosofos y procesos
+    for (int i = 0; i < N; ++i) {
+        int pid = procesos.crear(1, 0); // tiempo, llegada
+        filosofos.emplace_back(i, HandleProceso{&procesos, pid}, &tenedores[i], &tenedores[(i + 1) % N], traza);
+    }
+
+    // Simular varias rondas
+    for (int r = 0; r < rondas; ++r) {
+        cout << "\n--- RONDA " << r + 1 << " ---\n";
+        for (auto &f : filosofos) f.ciclo(r + 1, pausa_ms);
+
+        cout << "\nEstado tras ronda " << r + 1 << ":\n";
+        for (auto &f : filosofos) {
+            cout << "  Filosofo " << f.getId() << " -> " << f.estado() << "\n";
+        }
+    }
+
+    cout << "\n=== Fin de la simulacion de los filosofos ===\n";
+}
+
+
+// ------------------------- Cena de los Filosofos con hilos reales -------------------------
+const char *nombre_estrategia_cena(EstrategiaCena e) {
+    switch (e) {
+        case EstrategiaCena::INGENUA:      return "ingenua";
+        case EstrategiaCena::ORDEN:        return "orden";
+        case EstrategiaCena::CAMARERO:     return "camarero";
+        case EstrategiaCena::CHANDY_MISRA: return "chandy";
+    }
+    return "?";
+}
+
+bool estrategia_cena_desde_texto(const string &s, EstrategiaCena &e) {
+    if (s == "ingenua") e = EstrategiaCena::INGENUA;
+    else if (s == "orden") e = EstrategiaCena::ORDEN;
+    else if (s == "camarero") e = EstrategiaCena::CAMARERO;
+    else if (s == "chandy") e = EstrategiaCena::CHANDY_MISRA;
+    else return false;
+    return true;
+}
+
+// Estado de Chandy-Misra de un tenedor; lo protege su mutex
+struct TenedorCM {
+    mutex mtx;
+    int dueno = -1;
+    bool sucio = true;
+    bool pedido = false; // el vecino que no lo tiene lo esta esperando
+};
+
+// Timbre de un filosofo de Chandy-Misra: lo tocan al entregarle un tenedor
+struct alignas(64) TimbreCM {
+    mutex mtx;
+    condition_variable cv;
+    bool avisado = false;
+};
+
+struct alignas(64) EstadisticaFilosofo {
+    long long comidas = 0;
+    double espera_total_us = 0, espera_max_us = 0;
+};
+
+// Busca un ciclo en el grafo de espera: cada filosofo espera a lo sumo un tenedor, asi que
+// cada nodo tiene a lo sumo una arista (filosofo -> dueño del tenedor esperado)
+static vector<int> ciclo_de_espera(const vector<int> &siguiente) {
+    int n = (int)siguiente.size();
+    vector<uint8_t> color(n, 0); // 0 sin visitar, 1 en el camino actual, 2 terminado
+    for (int i = 0; i < n; ++i) {
+        if (color[i]) continue;
+        int v = i;
+        while (v >= 0 && color[v] == 0) { color[v] = 1; v = siguiente[v]; }
+        if (v >= 0 && color[v] == 1) {
+            vector<int> ciclo{v};
+            for (int w = siguiente[v]; w != v; w = siguiente[w]) ciclo.push_back(w);
+            return ciclo;
+        }
+        for (v = i; v >= 0 && color[v] == 1; v = siguiente[v]) color[v] = 2;
+    }
+    return {};
+}
+
+ResultadoCena ejecutar_cena_hilos(const ParametrosCena &par) {
+    using reloj = chrono::steady_clock;
+    const int N = par.filosofos;
+    const EstrategiaCena e = par.estrategia;
+    ResultadoCena r;
+
+    // Grafo de espera, publicado por los filosofos y leido por el vigilante
+    unique_ptr<atomic<int>[]> dueno(new atomic<int>[N]), espera(new atomic<int>[N]);
+    for (int i = 0; i < N; ++i) { dueno[i] = -1; espera[i] = -1; }
+
+    unique_ptr<timed_mutex[]> tenedores(new timed_mutex[N]);
+    SemaforoSimulado camarero(N - 1);
+    // Chandy-Misra: cada tenedor empieza sucio en manos del vecino de menor indice (grafo aciclico)
+    unique_ptr<TenedorCM[]> cm;
+    unique_ptr<TimbreCM[]> timbres;
+    unique_ptr<bool[]> comiendo;
+    if (e == EstrategiaCena::CHANDY_MISRA) {
+        cm.reset(new TenedorCM[N]);
+        timbres.reset(new TimbreCM[N]);
+        comiendo.reset(new bool[N]());
+        for (int f = 0; f < N; ++f) {
+            cm[f].dueno = f == 0 ? 0 : f - 1;
+            dueno[f] = cm[f].dueno;
+        }
+    }
+
+    vector<EstadisticaFilosofo> stats(N);
+    atomic<long long> comidas_total{0};
+    atomic<int> listos{0}, terminados{0};
+    atomic<bool> arranque{false}, abortar{false};
+    mutex mtx_fin;
+    condition_variable cv_fin;
+
+    // Toma un tenedor protegido por mutex; solo falla si el vigilante aborto la corrida
+    auto tomar = [&](int p, int f) {
+        espera[p].store(f, memory_order_relaxed);
+        while (!tenedores[f].try_lock_for(chrono::milliseconds(10)))
+            if (abortar.load(memory_order_relaxed)) return false;
+        dueno[f].store(p, memory_order_relaxed);
+        espera[p].store(-1, memory_order_relaxed);
+        return true;
+    };
+    auto soltar = [&](int f) {
+        dueno[f].store(-1, memory_order_relaxed);
+        tenedores[f].unlock();
+    };
+    auto tocar = [&](int q) {
+        {
+            lock_guard<mutex> lk(timbres[q].mtx);
+            timbres[q].avisado = true;
+        }
+        timbres[q].cv.notify_one();
+    };
+
+    // Chandy-Misra: se bloquean los dos tenedores (en orden de indice, solo para leer su estado
+    // de forma consistente); un tenedor sucio de un vecino que no esta comiendo pasa limpio al
+    // que lo pide, uno limpio o en uso queda pedido y su dueño lo entrega al terminar de comer.
+    auto comer_chandy = [&](int p, int a, int b) {
+        int lo = min(a, b), hi = max(a, b);
+        for (;;) {
+            {
+                lock_guard<mutex> l1(cm[lo].mtx), l2(cm[hi].mtx);
+                int falta = -1;
+                for (int f : {a, b}) {
+                    TenedorCM &t = cm[f];
+                    if (t.dueno == p) continue;
+                    if (t.sucio && !comiendo[t.dueno]) {
+                        t.dueno = p; t.sucio = false; t.pedido = false;
+                        dueno[f].store(p, memory_order_relaxed);
+                    } else {
+                        t.pedido = true;
+                        if (falta < 0) falta = f;
+                    }
+                }
+                espera[p].store(falta, memory_order_relaxed);
+                if (falta < 0) { comiendo[p] = true; return true; }
+            }
+            unique_lock<mutex> lk(timbres[p].mtx);
+            timbres[p].cv.wait_for(lk, chrono::milliseconds(10), [&] { return timbres[p].avisado; });
+            timbres[p].avisado = false;
+            if (abortar.load(memory_order_relaxed)) return false;
+        }
+    };
+    auto soltar_chandy = [&](int p, int a, int b) {
+        int lo = min(a, b), hi = max(a, b);
+        int avisar[2], n_avisar = 0;
+        {
+            lock_guard<mutex> l1(cm[lo].mtx), l2(cm[hi].mtx);
+            comiendo[p] = false;
+            for (int f : {a, b}) {
+                TenedorCM &t = cm[f];
+                t.sucio = true;
+                if (t.pedido) {
+                    int vecino = f == a ? (p + N - 1) % N : (p + 1) % N;
+                    t.dueno = vecino; t.sucio = false; t.pedido = false;
+                    dueno[f].store(vecino, memory_order_relaxed);
+                    avisar[n_avisar++] = vecino;
+                }
+            }
+        }
+        for (int i = 0; i < n_avisar; ++i) tocar(avisar[i]);
+    };
+
+    auto filosofo = [&](int p) {
+        int izq = p, der = (p + 1) % N;
+        EstadisticaFilosofo &st = stats[p];
+        listos.fetch_add(1);
+        while (!arranque.load(memory_order_acquire)) this_thread::yield();
+        for (int k = 0; k < par.comidas; ++k) {
+            if (par.pensar_us > 0) this_thread::sleep_for(chrono::microseconds(par.pensar_us));
+            auto t0 = reloj::now();
+            bool ok = true;
+            int primero = izq, segundo = der;
+            if (e == EstrategiaCena::ORDEN && der < izq) swap(primero, segundo);
+            if (e == EstrategiaCena::CHANDY_MISRA) {
+                ok = comer_chandy(p, izq, der);
+            } else {
+                if (e == EstrategiaCena::CAMARERO) camarero.wait();
+                ok = tomar(p, primero);
+                if (ok && !tomar(p, segundo)) { soltar(primero); ok = false; }
+                if (!ok && e == EstrategiaCena::CAMARERO) camarero.signal(); // libera la silla al abortar
+            }
+            if (!ok) break;
+            double us = chrono::duration<double, micro>(reloj::now() - t0).count();
+            st.espera_total_us += us;
+            st.espera_max_us = max(st.espera_max_us, us);
+            st.comidas++;
+            comidas_total.fetch_add(1, memory_order_relaxed);
+            if (par.comer_us > 0) this_thread::sleep_for(chrono::microseconds(par.comer_us));
+            if (e == EstrategiaCena::CHANDY_MISRA) {
+                soltar_chandy(p, izq, der);
+            } else {
+                soltar(segundo);
+                soltar(primero);
+                if (e == EstrategiaCena::CAMARERO) camarero.signal();
+            }
+        }
+        if (terminados.fetch_add(1) + 1 == N) {
+            lock_guard<mutex> lk(mtx_fin);
+            cv_fin.notify_one();
+        }
+    };
+
+    vector<thread> hilos;
+    hilos.reserve(N);
+    for (int i = 0; i < N; ++i) hilos.emplace_back(filosofo, i);
+    while (listos.load() < N) this_thread::yield();
+    auto t0 = reloj::now();
+    arranque.store(true, memory_order_release);
+
+    // Vigilante: la foto del grafo no es atomica, asi que un ciclo solo cuenta como deadlock si
+    // aparece igual en dos revisiones seguidas sin ninguna comida entre ellas
+    long long comidas_antes = -1;
+    vector<int> siguiente(N), sospechoso;
+    for (;;) {
+        {
+            unique_lock<mutex> lk(mtx_fin);
+            if (cv_fin.wait_for(lk, chrono::milliseconds(50), [&] { return terminados.load() == N; })) break;
+        }
+        long long c = comidas_total.load();
+        vector<int> ciclo;
+        if (c == comidas_antes) {
+            for (int i = 0; i < N; ++i) {
+                int f = espera[i].load(memory_order_relaxed);
+                siguiente[i] = f < 0 ? -1 : dueno[f].load(memory_order_relaxed);
+            }
+            ciclo = ciclo_de_espera(siguiente);
+            sort(ciclo.begin(), ciclo.end());
+        }
+        if (!ciclo.empty() && ciclo == sospechoso) {
+            r.deadlock = true;
+            r.ciclo = move(ciclo);
+            abortar.store(true);
+            break;
+        }
+        sospechoso = move(ciclo);
+        comidas_antes = c;
+    }
+    for (auto &h : hilos) h.join();
+    r.segundos = chrono::duration<double>(reloj::now() - t0).count();
+
+    double espera_total = 0;
+    for (int i = 0; i < N; ++i) {
+        r.comidas += stats[i].comidas;
+        espera_total += stats[i].espera_total_us;
+        if (stats[i].espera_max_us > r.espera_max_us) {
+            r.espera_max_us = stats[i].espera_max_us;
+            r.filosofo_espera_max = i;
+        }
+    }
+    r.comidas_por_segundo = r.segundos > 0 ? r.comidas / r.segundos : 0;
+    r.espera_media_us = r.comidas ? espera_total / r.comidas : 0;
+    return r;
+}
+
+void mostrar_resultados_cena(const ParametrosCena &par, const vector<pair<EstrategiaCena, ResultadoCena>> &res) {
+    cout << "\n=== Cena con hilos: " << par.filosofos << " filosofos, " << par.comidas << " comidas c/u";
+    if (par.pensar_us || par.comer_us) cout << ", pensar " << par.pensar_us << " us, comer " << par.comer_us << " us";
+    cout << " (" << thread::hardware_concurrency() << " hilos de hardware) ===\n";
+    cout << left << setw(10) << "Estrategia" << right << setw(12) << "comidas" << setw(10) << "seg"
+         << setw(14) << "comidas/s" << setw(14) << "espera med" << setw(14) << "espera max" << "  deadlock\n";
+    for (auto &[est, r] : res) {
+        cout << left << setw(10) << nombre_estrategia_cena(est) << right << setw(12) << r.comidas << fixed
+             << setprecision(3) << setw(10) << r.segundos << setprecision(0) << setw(14) << r.comidas_por_segundo
+             << setprecision(1) << setw(11) << r.espera_media_us << " us" << setw(11) << r.espera_max_us << " us  ";
+        if (!r.deadlock) {
+            cout << "no\n";
+            continue;
+        }
+        cout << "SI, ciclo de " << r.ciclo.size() << ":";
+        for (size_t i = 0; i < r.ciclo.size() && i < 8; ++i) cout << " " << r.ciclo[i];
+        cout << (r.ciclo.size() > 8 ? " ...\n" : "\n");
+    }
+    for (auto &[est, r] : res)
+        if (r.filosofo_espera_max >= 0)
+            cout << "  [" << nombre_estrategia_cena(est) << "] mayor espera: filosofo " << r.filosofo_espera_max << "\n";
+}
+
+
+// ------------------------- Productor-Consumidor con hilos reales -------------------------
+const char *nombre_buffer_pc(TipoBufferPC t) {
+    switch (t) {
+        case TipoBufferPC::SPSC:  return "SPSC";
+        case TipoBufferPC::MPMC:  return "MPMC";
+        case TipoBufferPC::MUTEX: return "MUTEX";
+    }
+    return "?";
+}
+
+bool buffer_pc_desde_texto(const string &s, TipoBufferPC &t) {
+    if (s == "spsc") t = TipoBufferPC::SPSC;
+    else if (s == "mpmc") t = TipoBufferPC::MPMC;
+    else if (s == "mutex") t = TipoBufferPC::MUTEX;
+    else return false;
+    return true;
+}
+
+// Contadores de cada hilo en su propia linea de cache: se suman al terminar
+struct alignas(64) ContadoresHiloPC {
+    long long reintentos = 0, lleno = 0, vacio = 0;
+    long long cuenta = 0, suma = 0;
+    vector<double> latencias;
+};
+
+ResultadoPC ejecutar_productor_consumidor(const ParametrosPC &par) {
+    using reloj = chrono::steady_clock;
+    const int P = par.productores, C = par.consumidores;
+    const long long n = par.items;
+    ResultadoPC r;
+    r.items = n;
+
+    unique_ptr<AnilloMPMC> mpmc;
+    unique_ptr<BufferMutexSemaforo> base;
+    vector<unique_ptr<AnilloSPSC>> anillos;
+    if (par.tipo == TipoBufferPC::SPSC)
+        for (int i = 0; i < P; ++i) anillos.emplace_back(new AnilloSPSC(par.capacidad));
+    else if (par.tipo == TipoBufferPC::MPMC) mpmc.reset(new AnilloMPMC(par.capacidad));
+    else base.reset(new BufferMutexSemaforo(par.capacidad));
+
+    vector<ContadoresHiloPC> prod(P), cons(C);
+    atomic<int> listos{0};
+    atomic<bool> arranque{false};
+    atomic<long long> reclamados{0};
+    auto esperar_arranque = [&] {
+        listos.fetch_add(1);
+        while (!arranque.load(memory_order_acquire)) this_thread::yield();
+    };
+
+    // El productor i genera i+1, i+1+P, ... <= n: entre todos, cada valor de 1..n una vez
+    auto productor = [&](int i) {
+        ContadoresHiloPC &c = prod[i];
+        c.latencias.reserve((size_t)(n / P / 16 + 1));
+        esperar_arranque();
+        long long k = 0;
+        for (long long v = i + 1; v <= n; v += P, ++k) {
+            bool medir = (k & 15) == 0;
+            reloj::time_point t0;
+            if (medir) t0 = reloj::now();
+            if (par.tipo == TipoBufferPC::SPSC) {
+                while (!anillos[i]->encolar(v)) { c.lleno++; this_thread::yield(); }
+            } else if (par.tipo == TipoBufferPC::MPMC) {
+                while (!mpmc->encolar(v, c.reintentos)) { c.lleno++; this_thread::yield(); }
+            } else {
+                base->encolar(v, c.reintentos);
+            }
+            if (medir) c.latencias.push_back(chrono::duration<double, nano>(reloj::now() - t0).count());
+        }
+    };
+
+    // SPSC: el consumidor i vacia el anillo de su pareja; los demas reclaman turnos hasta llegar a n
+    auto consumidor = [&](int i) {
+        ContadoresHiloPC &c = cons[i];
+        esperar_arranque();
+        long long v;
+        if (par.tipo == TipoBufferPC::SPSC) {
+            long long propios = n >= i + 1 ? (n - (i + 1)) / P + 1 : 0;
+            for (long long k = 0; k < propios; ++k) {
+                while (!anillos[i]->desencolar(v)) { c.vacio++; this_thread::yield(); }
+                c.cuenta++; c.suma += v;
+            }
+            return;
+        }
+        while (reclamados.fetch_add(1, memory_order_relaxed) < n) {
+            if (par.tipo == TipoBufferPC::MPMC) {
+                while (!mpmc->desencolar(v, c.reintentos)) { c.vacio++; this_thread::yield(); }
+            } else {
+                v = base->desencolar(c.reintentos);
+            }
+            c.cuenta++; c.suma += v;
+        }
+    };
+
+    vector<thread> hilos;
+    for (int i = 0; i < P; ++i) hilos.emplace_back(productor, i);
+    for (int i = 0; i < C; ++i) hilos.emplace_back(consumidor, i);
+    while (listos.load() < P + C) this_thread::yield();
+    auto t0 = reloj::now();
+    arranque.store(true, memory_order_release);
+    for (auto &h : hilos) h.join();
+    r.segundos = chrono::duration<double>(reloj::now() - t0).count();
+    r.ops_por_segundo = r.segundos > 0 ? n / r.segundos : 0;
+
+    vector<double> lat;
+    long long cuenta = 0, suma = 0;
+    for (auto &c : prod) {
+        r.reintentos += c.reintentos; r.lleno += c.lleno;
+        lat.insert(lat.end(), c.latencias.begin(), c.latencias.end());
+    }
+    for (auto &c : cons) {
+        r.reintentos += c.reintentos; r.vacio += c.vacio;
+        cuenta += c.cuenta; suma += c.suma;
+    }
+    if (base) {
+        r.lleno = base->vacios.metricas().bloqueos;
+        r.vacio = base->items.metricas().bloqueos;
+    }
+    auto percentil = [&](double q) {
+        if (lat.empty()) return 0.0;
+        size_t k = min(lat.size() - 1, (size_t)(q * lat.size()));
+        nth_element(lat.begin(), lat.begin() + k, lat.end());
+        return lat[k];
+    };
+    r.p50_ns = percentil(0.50);
+    r.p99_ns = percentil(0.99);
+    r.verificado = cuenta == n && suma == n * (n + 1) / 2;
+    return r;
+}
+
+void mostrar_resultados_pc(const ParametrosPC &par, const vector<pair<TipoBufferPC, ResultadoPC>> &res) {
+    cout << "\n=== Productor-Consumidor con hilos: " << par.productores << " productores, " << par.consumidores
+         << " consumidores, capacidad " << par.capacidad << ", " << par.items << " items ("
+         << thread::hardware_concurrency() << " hilos de hardware) ===\n";
+    cout << left << setw(8) << "Buffer" << right << setw(14) << "ops/s" << setw(12) << "p50 ns" << setw(12) << "p99 ns"
+         << setw(13) << "reintentos" << setw(12) << "lleno" << setw(12) << "vacio" << "  verificacion\n";
+    for (auto &[tipo, r] : res) {
+        cout << left << setw(8) << nombre_buffer_pc(tipo) << right << fixed << setprecision(0)
+             << setw(14) << r.ops_por_segundo << setw(12) << r.p50_ns << setw(12) << r.p99_ns
+             << setw(13) << r.reintentos << setw(12) << r.lleno << setw(12) << r.vacio
+             << "  " << (r.verificado ? "OK" : "FALLO") << "\n";
+    }
+    cout << "  (latencia de encolado muestreada 1 de cada 16; reintentos = CAS perdidos o mutex ocupado;\n"
+         << "   lleno/vacio = veces que un hilo encontro el buffer lleno o vacio y tuvo que esperar)\n";
+}
+
+
+// ------------------------- Cargas de trabajo binarias -------------------------
+bool generar_carga(const string &ruta, const ParametrosCarga &par) {
+    mt19937_64 rng(par.semilla);
+    uniform_real_distribution<double> u01(0.0, 1.0);
+    exponential_distribution<double> entre_llegadas(par.llegada_media > 0 ? 1.0 / par.llegada_media : 1.0);
+    const double alfa = 1.5, xm = par.rafaga_media * (alfa - 1) / alfa;
+    const uint32_t MAX_RAFAGA = 1u << 24, MAX_LLEGADA = INT_MAX / 4;
+
+    auto exponencial = [&](double media) { return -media * log(1.0 - u01(rng)); };
+    auto rafaga = [&]() -> uint32_t {
+        double r;
+        switch (par.rafaga) {
+            case DistribucionRafaga::PARETO:  r = xm / pow(1.0 - u01(rng), 1.0 / alfa); break;
+            case DistribucionRafaga::BIMODAL:
+                r = u01(rng) < 0.8 ? exponencial(par.rafaga_media / 4) : exponencial(par.rafaga_media * 4); break;
+            default:                          r = exponencial(par.rafaga_media); break;
+        }
+        return (uint32_t)min<double>(MAX_RAFAGA, max(1.0, round(r)));
+    };
+
+    size_t n = par.n, a = n * par.paginas, e = n * par.io;
+    vector<uint32_t> tiempo(n), llegada(n), acceso_pid(a), acceso_pagina(a), io_pid(e), io_duracion(e);
+    vector<uint8_t> io_dispositivo(e), io_prioridad(e);
+    double t = 0;
+    int calientes = max(1, par.rango_paginas / 5);
+    for (size_t i = 0; i < n; ++i) {
+        tiempo[i] = rafaga();
+        if (par.llegada_media > 0 && i > 0) t += entre_llegadas(rng);
+        llegada[i] = (uint32_t)min<double>(MAX_LLEGADA, t);
+        for (int k = 0; k < par.paginas; ++k) {
+            size_t j = i * par.paginas + k;
+            acceso_pid[j] = (uint32_t)(i + 1);
+            acceso_pagina[j] = (uint32_t)(u01(rng) < 0.8 ? rng() % calientes : rng() % par.rango_paginas);
+        }
+        for (int k = 0; k < par.io; ++k) {
+            size_t j = i * par.io + k;
+            io_pid[j] = (uint32_t)(i + 1);
+            io_duracion[j] = (uint32_t)max(1.0, round(exponencial(5)));
+            io_dispositivo[j] = (uint8_t)(rng() % 3);
+            io_prioridad[j] = (uint8_t)(rng() % 4);
+        }
+    }
+
+    ofstream out(ruta, ios::binary | ios::trunc);
+    if (!out) return false;
+    CabeceraCarga cab{{'S', 'O', 'W', 'L'}, 1, par.semilla, n, a, e};
+    out.write((const char *)&cab, sizeof(cab));
+    auto escribir = [&](const auto &v) { out.write((const char *)v.data(), v.size() * sizeof(v[0])); };
+    escribir(tiempo); escribir(llegada);
+    escribir(acceso_pid); escribir(acceso_pagina);
+    escribir(io_pid); escribir(io_duracion); escribir(io_dispositivo); escribir(io_prioridad);
+    return (bool)out;
+}
+
+
+// ------------------------- Barrido de parametros (sweep) -------------------------
+void barrido_cpu(const CargaTrabajo &carga, int qmin, int qmax, int ncpus, PoolHilos &pool) {
+    struct Fila { string politica; int quantum; ResumenPlanificador r; };
+    vector<Fila> filas;
+    for (int q = qmin; q <= qmax; ++q) filas.push_back({"RR", q, {}});
+    filas.push_back({"SJF", 0, {}});
+    filas.push_back({"CFS", 0, {}});
+
+    auto t0 = chrono::steady_clock::now();
+    pool.ejecutar((int)filas.size(), [&](int i) {
+        GestorMarcos gestor; // sin accesos: solo recibe liberar_proceso
+        if (filas[i].politica == "RR") {
+            PlanificadorRR rr(filas[i].quantum);
+            rr.set_nucleos(ncpus);
+            for (auto &p : carga.procesos) rr.crear_proceso(p.tiempo, p.llegada);
+            rr.ejecutar_hasta_terminar(gestor);
+            filas[i].r = rr.resumen();
+        } else if (filas[i].politica == "CFS") {
+            PlanificadorCFS cfs;
+            cfs.set_nucleos(ncpus);
+            for (auto &p : carga.procesos) cfs.crear_proceso(p.tiempo, p.llegada);
+            cfs.ejecutar_hasta_terminar(gestor);
+            filas[i].r = cfs.resumen();
+        } else {
+            PlanificadorSJF sjf;
+            sjf.set_nucleos(ncpus);
+            for (auto &p : carga.procesos) sjf.crear_proceso(p.tiempo, p.llegada);
+            sjf.ejecutar_hasta_terminar(gestor);
+            filas[i].r = sjf.resumen();
+        }
+    });
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    cout << fixed << setprecision(3);
+    cout << "\n[SWEEP] Planificacion: " << filas.size() << " configuraciones | " << carga.procesos.size()
+         << " procesos | " << ncpus << " CPU(s) | " << pool.hilos() << " hilos | " << ms << " ms\n";
+    cout << "Politica\tQuantum\tEspera\tTurnaround\tMakespan\tUtil\tDespachos\n";
+    int mejor = 0;
+    for (size_t i = 0; i < filas.size(); ++i) {
+        auto &f = filas[i];
+        cout << f.politica << "\t" << (f.politica == "RR" ? to_string(f.quantum) : "-") << "\t"
+             << f.r.espera_promedio << "\t" << f.r.retorno_promedio << "\t" << f.r.makespan << "\t"
+             << f.r.utilizacion << "\t" << f.r.despachos << "\n";
+        if (f.r.retorno_promedio < filas[mejor].r.retorno_promedio) mejor = (int)i;
+    }
+    cout << "Menor turnaround: " << filas[mejor].politica;
+    if (filas[mejor].politica == "RR") cout << " q=" << filas[mejor].quantum;
+    cout << " (" << filas[mejor].r.retorno_promedio << ")\n";
+}
+
+
+void barrido_memoria(const CargaTrabajo &carga, int mmin, int mmax, int ventana, PoolHilos &pool) {
+    struct Fila { PoliticaMemoria politica; int marcos; long long fallos; double ms; };
+    const PoliticaMemoria politicas[] = {PoliticaMemoria::FIFO, PoliticaMemoria::LRU, PoliticaMemoria::WS,
+                                         PoliticaMemoria::CLOCK, PoliticaMemoria::SEGUNDA_OPORTUNIDAD,
+                                         PoliticaMemoria::AGING};
+    const int NP = sizeof(politicas) / sizeof(politicas[0]);
+    vector<Fila> filas;
+    for (int m = mmin; m <= mmax; ++m)
+        for (auto pol : politicas) filas.push_back({pol, m, 0, 0});
+
+    auto t0 = chrono::steady_clock::now();
+    pool.ejecutar((int)filas.size(), [&](int i) {
+        auto ti = chrono::steady_clock::now();
+        GestorMarcos gestor(filas[i].marcos, filas[i].politica, ventana);
+        bool hit;
+        for (auto &[pid, pag] : carga.accesos) gestor.acceder_pagina(pid, pag, hit);
+        filas[i].fallos = gestor.get_fallos();
+        filas[i].ms = chrono::duration<double, milli>(chrono::steady_clock::now() - ti).count();
+    });
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    size_t accesos = carga.accesos.size();
+    cout << fixed << setprecision(3);
+    cout << "\n[SWEEP] Memoria: " << filas.size() << " configuraciones | " << accesos << " accesos | ventana WS="
+         << ventana << " | " << pool.hilos() << " hilos | " << ms << " ms\n";
+    cout << "Marcos";
+    for (auto pol : politicas) cout << "\t" << nombre_politica(pol);
+    cout << "\t(fallos | tasa de fallos)\n";
+    vector<double> ms_politica(NP, 0);
+    for (size_t i = 0; i < filas.size(); i += NP) {
+        cout << filas[i].marcos;
+        for (int j = 0; j < NP; ++j) {
+            cout << "\t" << filas[i + j].fallos << " | "
+                 << (accesos ? (double)filas[i + j].fallos / accesos : 0.0);
+            ms_politica[j] += filas[i + j].ms;
+        }
+        cout << "\n";
+    }
+    // costo por acceso promedio de cada politica sobre todas las cantidades de marcos
+    cout << "ns/acceso";
+    double total_accesos = (double)accesos * (mmax - mmin + 1);
+    for (int j = 0; j < NP; ++j) cout << "\t" << (total_accesos ? ms_politica[j] * 1e6 / total_accesos : 0.0);
+    cout << "\n";
+}
+
+
+void barrido_tlb(const CargaTrabajo &carga, int qmin, int qmax, const ConfigTLB &tlb, int marcos, PoolHilos &pool) {
+    struct Fila { int quantum; bool asid; long long despachos, aciertos, fallos, vaciados, fallos_pagina; double costo; };
+    vector<Fila> filas;
+    for (int q = qmin; q <= qmax; ++q)
+        for (bool asid : {false, true}) filas.push_back({q, asid, 0, 0, 0, 0, 0, 0});
+
+    // referencias de cada proceso en el orden de la carga
+    vector<vector<int>> refs(carga.procesos.size() + 1);
+    for (auto &[pid, pag] : carga.accesos)
+        if (pid >= 1 && pid < (int)refs.size()) refs[pid].push_back(pag);
+    long long limite = 0;
+    for (auto &p : carga.procesos) limite = max<long long>(limite, p.llegada);
+    for (auto &p : carga.procesos) limite += p.tiempo;
+    limite = min<long long>(limite + 1, INT_MAX / 2);
+
+    auto t0 = chrono::steady_clock::now();
+    pool.ejecutar((int)filas.size(), [&](int i) {
+        Fila &f = filas[i];
+        ConfigTLB c = tlb;
+        c.asid = f.asid;
+        GestorMarcos gestor(marcos, PoliticaMemoria::LRU);
+        gestor.set_tlb(c);
+        PlanificadorRR rr(f.quantum);
+        for (auto &p : carga.procesos) rr.crear_proceso(p.tiempo, p.llegada);
+        vector<size_t> siguiente(refs.size(), 0);
+        long long costo = 0, accesos = 0;
+        bool hit;
+        while (!rr.completo() && rr.get_tiempo() < limite) {
+            rr.tick(gestor);
+            int p = rr.ultimo_en_cpu(0);
+            if (p <= 0 || p >= (int)refs.size() || refs[p].empty()) continue;
+            costo += gestor.acceder_pagina(p, refs[p][siguiente[p]++ % refs[p].size()], hit);
+            accesos++;
+        }
+        f.despachos = rr.resumen().despachos;
+        f.aciertos = gestor.get_tlb().aciertos;
+        f.fallos = gestor.get_tlb().fallos;
+        f.vaciados = gestor.get_tlb().vaciados;
+        f.fallos_pagina = gestor.get_fallos();
+        f.costo = accesos ? (double)costo / accesos : 0.0;
+    });
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    cout << fixed << setprecision(3);
+    cout << "\n[SWEEP] TLB: " << tlb.entradas << " entradas, " << tlb.asociatividad << " vias, "
+         << (tlb.reemplazo == ReemplazoTLB::LRU ? "LRU" : "aleatorio") << " | " << marcos << " marcos LRU | "
+         << carga.procesos.size() << " procesos | " << pool.hilos() << " hilos | " << ms << " ms\n";
+    cout << "Quantum\tDespachos\tAciertos TLB (vaciado | ASID)\tVaciados\tFallos pag\tTicks/acceso (vaciado | ASID)\n";
+    for (size_t i = 0; i < filas.size(); i += 2) {
+        const Fila &v = filas[i], &a = filas[i + 1];
+        auto tasa = [](const Fila &f) { return f.aciertos + f.fallos ? (double)f.aciertos / (f.aciertos + f.fallos) : 0.0; };
+        cout << v.quantum << "\t" << v.despachos << "\t" << tasa(v) << " | " << tasa(a) << "\t" << v.vaciados
+             << "\t" << v.fallos_pagina << "\t" << v.costo << " | " << a.costo << "\n";
+    }
+}
+
+
+// ------------------------- Curvas de fallos (Mattson) -------------------------
+// Arbol de Fenwick sobre posiciones de tiempo: 1 en el ultimo acceso de cada pagina.
+// La distancia de pila de un acceso es la cantidad de unos entre su uso anterior y ahora.
+struct ArbolFenwick {
+    vector<int> t;
+    explicit ArbolFenwick(size_t n) : t(n + 1, 0) {}
+    void sumar(size_t i, int v) { for (++i; i < t.size(); i += i & -i) t[i] += v; }
+    int prefijo(size_t i) const { int s = 0; for (++i; i > 0; i -= i & -i) s += t[i]; return s; } // [0, i]
+};
+
+CurvaFallos calcular_curva_fallos(const vector<uint64_t> &referencias, int max_marcos, bool con_opt, PoolHilos &pool) {
+    CurvaFallos c;
+    size_t n = referencias.size();
+    c.accesos = (long long)n;
+
+    // paginas -> ids densos (ordenar una copia evita un hash por acceso)
+    vector<uint64_t> distintas(referencias);
+    sort(distintas.begin(), distintas.end());
+    distintas.erase(unique(distintas.begin(), distintas.end()), distintas.end());
+    c.paginas_distintas = (int)distintas.size();
+    vector<int> id(n);
+    for (size_t t = 0; t < n; ++t)
+        id[t] = (int)(lower_bound(distintas.begin(), distintas.end(), referencias[t]) - distintas.begin());
+    if (max_marcos <= 0) max_marcos = max(1, c.paginas_distintas);
+
+    // LRU: histograma de distancias de pila en O(n log n)
+    auto t0 = chrono::steady_clock::now();
+    vector<long long> histograma(max_marcos + 2, 0); // [max_marcos+1] = distancia mayor o fria
+    {
+        ArbolFenwick arbol(n);
+        vector<int> ultimo(distintas.size(), -1);
+        for (size_t t = 0; t < n; ++t) {
+            int p = ultimo[id[t]];
+            if (p < 0) {
+                histograma[max_marcos + 1]++;
+            } else {
+                int d = arbol.prefijo(t) - arbol.prefijo(p) + 1; // paginas distintas en (p, t) + la propia
+                histograma[min(d, max_marcos + 1)]++;
+                arbol.sumar(p, -1);
+            }
+            arbol.sumar(t, 1);
+            ultimo[id[t]] = (int)t;
+        }
+    }
+    c.fallos_lru.assign(max_marcos + 1, 0);
+    long long aciertos = 0;
+    for (int m = 0; m <= max_marcos; ++m) {
+        aciertos += histograma[m];
+        c.fallos_lru[m] = (long long)n - aciertos;
+    }
+    c.ms_lru = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+
+    // tamanos de la tabla: todos hasta 16, despues 4 por octava
+    for (int m = 1; m <= max_marcos; m = m < 16 ? m + 1 : max(m + 1, m + m / 4))
+        c.marcos_tabla.push_back(m);
+    if (c.marcos_tabla.back() != max_marcos) c.marcos_tabla.push_back(max_marcos);
+    if (!con_opt) return c;
+
+    // OPT: expulsa la pagina residente cuyo proximo uso es el mas lejano
+    t0 = chrono::steady_clock::now();
+    vector<int> proximo(n);
+    {
+        vector<int> siguiente_de(distintas.size(), INT_MAX);
+        for (size_t t = n; t-- > 0;) {
+            proximo[t] = siguiente_de[id[t]];
+            siguiente_de[id[t]] = (int)t;
+        }
+    }
+    c.fallos_opt.assign(c.marcos_tabla.size(), 0);
+    pool.ejecutar((int)c.marcos_tabla.size(), [&](int fila) {
+        int m = c.marcos_tabla[fila];
+        vector<int> uso_residente(distintas.size(), -1); // proximo uso vigente, -1 = no residente
+        priority_queue<pair<int,int>> lejanos;           // (proximo uso, pagina); entradas viejas se descartan
+        int residentes = 0;
+        long long fallos = 0;
+        for (size_t t = 0; t < n; ++t) {
+            int pag = id[t];
+            if (uso_residente[pag] < 0) {
+                fallos++;
+                if (residentes == m) {
+                    while (uso_residente[lejanos.top().second] != lejanos.top().first) lejanos.pop();
+                    uso_residente[lejanos.top().second] = -1;
+                    lejanos.pop();
+                } else {
+                    residentes++;
+                }
+            }
+            uso_residente[pag] = proximo[t];
+            lejanos.push({proximo[t], pag});
+        }
+        c.fallos_opt[fila] = fallos;
+    });
+    c.ms_opt = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+    return c;
+}
+
+void imprimir_curva_fallos(const CurvaFallos &c) {
+    cout << fixed << setprecision(3);
+    bool con_opt = !c.fallos_opt.empty();
+    cout << "\n[MRC] " << c.accesos << " accesos | " << c.paginas_distintas << " paginas distintas (fallos frios)"
+         << " | LRU una pasada: " << c.ms_lru << " ms";
+    if (con_opt) cout << " | OPT " << c.marcos_tabla.size() << " tamanos: " << c.ms_opt << " ms";
+    cout << "\n";
+    if (c.accesos == 0) return;
+    cout << "Marcos\tFallos LRU\tTasa LRU" << (con_opt ? "\tFallos OPT\tTasa OPT" : "") << "\n";
+    for (size_t i = 0; i < c.marcos_tabla.size(); ++i) {
+        int m = c.marcos_tabla[i];
+        cout << m << "\t" << c.fallos_lru[m] << "\t" << (double)c.fallos_lru[m] / c.accesos;
+        if (con_opt) cout << "\t" << c.fallos_opt[i] << "\t" << (double)c.fallos_opt[i] / c.accesos;
+        cout << "\n";
+    }
+}
+
+
+// ------------------------- Reproduccion de trazas de memoria -------------------------
+static void entregar_lote(LoteAccesos &l, GestorMarcos &gestor, ResumenReproduccion &r) {
+    // compacta descartando pids fuera de rango; el caso comun no mueve nada
+    size_t k = 0;
+    for (size_t i = 0; i < l.n; ++i) {
+        if (l.pid[i] >= MAX_PID_TRAZA) { r.ignorados++; continue; }
+        l.pid[k] = l.pid[i]; l.pagina[k] = l.pagina[i]; l.escritura[k] = l.escritura[i];
+        k++;
+    }
+    r.ticks += gestor.acceder_lote(l.pid.data(), l.pagina.data(), l.escritura.data(), k);
+    r.accesos += k;
+    l.n = 0;
+}
+
+static bool leer_numero(const uint8_t *&p, const uint8_t *fin, uint32_t &x) {
+    while (p < fin && (*p == ' ' || *p == '\t')) p++;
+    if (p == fin || *p < '0' || *p > '9') return false;
+    uint64_t v = 0;
+    while (p < fin && *p >= '0' && *p <= '9' && v <= UINT32_MAX) v = v * 10 + (*p++ - '0');
+    if (v > UINT32_MAX) return false;
+    x = (uint32_t)v;
+    return true;
+}
+
+// Una linea por acceso; el lote se llena sin copiar lineas ni pasar por streams
+static void reproducir_texto(const uint8_t *p, const uint8_t *fin, GestorMarcos &gestor, ResumenReproduccion &r) {
+    const size_t LOTE = 1 << 16;
+    LoteAccesos l;
+    l.pid.resize(LOTE); l.pagina.resize(LOTE); l.escritura.resize(LOTE);
+    while (p < fin) {
+        while (p < fin && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+        if (p == fin) break;
+        const uint8_t *eol = (const uint8_t *)memchr(p, '\n', fin - p);
+        if (!eol) eol = fin;
+        if (*p != '\n' && *p != '#') {
+            if (eol - p >= 3 && memcmp(p, "mem", 3) == 0) p += 3;
+            uint32_t pid, pag;
+            if (leer_numero(p, eol, pid) && leer_numero(p, eol, pag)) {
+                while (p < eol && (*p == ' ' || *p == '\t')) p++;
+                l.pid[l.n] = pid;
+                l.pagina[l.n] = pag;
+                l.escritura[l.n] = (p < eol && (*p == 'w' || *p == 'W'));
+                if (++l.n == LOTE) entregar_lote(l, gestor, r);
+            } else {
+                r.ignorados++;
+            }
+        }
+        p = eol + (eol < fin);
+    }
+    entregar_lote(l, gestor, r);
+}
+
+bool reproducir_traza_memoria(const string &ruta, GestorMarcos &gestor, ResumenReproduccion &r) {
+    ArchivoMapeado m;
+    if (!m.abrir(ruta)) return false;
+    VistaCarga v;
+    if (v.abrir(m)) {
+        // carga de gen: las columnas del mapeo se entregan tal cual, sin copiar
+        r.formato = "carga binaria";
+        const size_t LOTE = 1 << 16;
+        LoteAccesos l;
+        for (uint64_t i = 0; i < v.cab->n_accesos; i += LOTE) {
+            l.n = (size_t)min<uint64_t>(LOTE, v.cab->n_accesos - i);
+            if (*max_element(v.acceso_pid + i, v.acceso_pid + i + l.n) < MAX_PID_TRAZA) {
+                r.ticks += gestor.acceder_lote(v.acceso_pid + i, v.acceso_pagina + i, nullptr, l.n);
+                r.accesos += l.n;
+                continue;
+            }
+            l.pid.assign(v.acceso_pid + i, v.acceso_pid + i + l.n);
+            l.pagina.assign(v.acceso_pagina + i, v.acceso_pagina + i + l.n);
+            l.escritura.assign(l.n, 0);
+            entregar_lote(l, gestor, r);
+        }
+        return true;
+    }
+    if (m.tam() >= 4 && memcmp(m.datos(), "SOTA", 4) == 0) {
+        r.formato = "traza columnar";
+        return recorrer_traza_accesos(m, [&](LoteAccesos &l) { entregar_lote(l, gestor, r); });
+    }
+    r.formato = "texto";
+    reproducir_texto(m.datos(), m.datos() + m.tam(), gestor, r);
+    return true;
+}
+
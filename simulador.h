@@ -0,0 +1,4776 @@
+#pragma once
+// Simulador de kernel: planificadores, memoria, sincronizacion, E/S y disco.
+// La CLI (main.cpp) y los benchmarks (bench.cpp) usan esta biblioteca.
+
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <string>
+#include <map>
+#include <unordered_map>
+#include <array>
+#include <set>
+#include <memory>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <sstream>
+#include <deque>
+#include <optional>
+#include <iomanip>
+#include <climits>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+
+// ------------------------- Tabla de procesos (struct-of-arrays) -------------------------
+// SUSPENDIDO: fuera de memoria por el control de carga del gestor de marcos (RR)
+enum class EstadoProceso : uint8_t { LISTO, EJECUTANDO, BLOQUEADO, TERMINADO, SUSPENDIDO };
+
+const char *nombre_estado(EstadoProceso e);
+
+// Pide paginas grandes (THP) para la capacidad reservada de una columna, antes de tocarla:
+// con millones de procesos el alta masiva deja de estar dominada por fallos de pagina de 4 KiB.
+template <typename T>
+void sugerir_paginas_grandes(std::vector<T> &v) {
+    const uintptr_t HUGE_2M = 2u << 20;
+    size_t bytes = v.capacity() * sizeof(T);
+    if (bytes < 2 * HUGE_2M) return;
+    uintptr_t ini = ((uintptr_t)v.data() + HUGE_2M - 1) & ~(HUGE_2M - 1);
+    uintptr_t fin = ((uintptr_t)v.data() + bytes) & ~(HUGE_2M - 1);
+    if (fin > ini) madvise((void *)ini, fin - ini, MADV_HUGEPAGE);
+}
+
+// Cada campo vive en su propio arreglo contiguo indexado por PID (el indice 0 no se usa).
+// Los recorridos calientes (estado, tiempo_restante...) leen memoria secuencial y un
+// proceso ocupa ~50 bytes en total, sin asignaciones individuales.
+class TablaProcesos {
+public:
+    // campos calientes
+    std::vector<EstadoProceso> estado;
+    std::vector<int> tiempo_restante;
+    std::vector<int> quantum_consumido;
+    std::vector<int> tiempo_llegada;
+    // campos de metricas
+    std::vector<int> tiempo_requerido;
+    std::vector<int> tiempo_inicio;
+    std::vector<int> tiempo_finalizacion;
+    std::vector<int> tiempo_espera_acumulado; // se actualiza al despachar (espera = despacho - tiempo_listo)
+    std::vector<int> tiempo_listo;            // instante en que entro por ultima vez a la cola de listos
+    std::vector<int> response_time;           // tiempo hasta primer start
+    std::vector<int> quantums_served;
+    // soporte de colas
+    std::vector<uint8_t> en_cola;             // evita encolar dos veces el mismo proceso
+    std::vector<int> indice_heap;             // posicion en el heap de listos de SJF (-1 si no esta)
+    std::vector<int16_t> nucleo;              // CPU a la que esta asignado (-1 = ninguna todavia)
+    const int *reloj = nullptr;               // tiempo_actual del planificador dueño
+
+    TablaProcesos() { reservar(0); crear(0, 0); } // PID 0 reservado
+
+    void reservar(size_t n) {
+        n += 1;
+        estado.reserve(n); tiempo_restante.reserve(n); quantum_consumido.reserve(n);
+        tiempo_llegada.reserve(n); tiempo_requerido.reserve(n); tiempo_inicio.reserve(n);
+        tiempo_finalizacion.reserve(n); tiempo_espera_acumulado.reserve(n); tiempo_listo.reserve(n);
+        response_time.reserve(n); quantums_served.reserve(n); en_cola.reserve(n); indice_heap.reserve(n);
+        nucleo.reserve(n);
+        sugerir_paginas_grandes(estado); sugerir_paginas_grandes(tiempo_restante);
+        sugerir_paginas_grandes(quantum_consumido); sugerir_paginas_grandes(tiempo_llegada);
+        sugerir_paginas_grandes(tiempo_requerido); sugerir_paginas_grandes(tiempo_inicio);
+        sugerir_paginas_grandes(tiempo_finalizacion); sugerir_paginas_grandes(tiempo_espera_acumulado);
+        sugerir_paginas_grandes(tiempo_listo); sugerir_paginas_grandes(response_time);
+        sugerir_paginas_grandes(quantums_served); sugerir_paginas_grandes(en_cola);
+        sugerir_paginas_grandes(indice_heap); sugerir_paginas_grandes(nucleo);
+    }
+
+    int crear(int tiempo, int llegada) {
+        int pid = (int)estado.size();
+        estado.push_back(EstadoProceso::LISTO);
+        tiempo_restante.push_back(tiempo);
+        quantum_consumido.push_back(0);
+        tiempo_llegada.push_back(llegada);
+        tiempo_requerido.push_back(tiempo);
+        tiempo_inicio.push_back(-1);
+        tiempo_finalizacion.push_back(-1);
+        tiempo_espera_acumulado.push_back(0);
+        tiempo_listo.push_back(llegada);
+        response_time.push_back(-1);
+        quantums_served.push_back(0);
+        en_cola.push_back(0);
+        indice_heap.push_back(-1);
+        nucleo.push_back(-1);
+        return pid;
+    }
+
+    // Alta masiva: cada columna crece una sola vez. Las llegadas son relativas a 'base'.
+    // Devuelve el PID del primero.
+    int crear_lote(size_t n, const uint32_t *tiempos, const uint32_t *llegadas, int base) {
+        int primero = (int)estado.size();
+        size_t total = estado.size() + n;
+        estado.resize(total, EstadoProceso::LISTO);
+        tiempo_restante.resize(total);
+        quantum_consumido.resize(total, 0);
+        tiempo_llegada.resize(total);
+        tiempo_requerido.resize(total);
+        tiempo_inicio.resize(total, -1);
+        tiempo_finalizacion.resize(total, -1);
+        tiempo_espera_acumulado.resize(total, 0);
+        tiempo_listo.resize(total);
+        response_time.resize(total, -1);
+        quantums_served.resize(total, 0);
+        en_cola.resize(total, 0);
+        indice_heap.resize(total, -1);
+        nucleo.resize(total, -1);
+        for (size_t i = 0; i < n; ++i) {
+            size_t pid = primero + i;
+            tiempo_restante[pid] = tiempo_requerido[pid] = (int)tiempos[i];
+            tiempo_llegada[pid] = tiempo_listo[pid] = base + (int)llegadas[i];
+        }
+        return primero;
+    }
+
+    bool existe(int pid) const { return pid > 0 && pid < (int)estado.size(); }
+    int cantidad() const { return (int)estado.size() - 1; }
+
+    // Semaforo o E/S: si esperaba en una cola de listos su espera se cierra ahora (el
+    // planificador lo descarta recien cuando llega al frente y no sabe cuando se bloqueo)
+    void bloquear(int pid) {
+        if (reloj && estado[pid] == EstadoProceso::LISTO && (en_cola[pid] || indice_heap[pid] >= 0))
+            tiempo_espera_acumulado[pid] += *reloj - tiempo_listo[pid];
+        estado[pid] = EstadoProceso::BLOQUEADO;
+    }
+};
+
+
+// Referencia liviana a un proceso: la tabla a la que pertenece + su PID
+struct HandleProceso {
+    TablaProcesos *tabla = nullptr;
+    int pid = 0;
+
+    explicit operator bool() const { return tabla != nullptr; }
+    EstadoProceso &estado() const { return tabla->estado[pid]; }
+    void bloquear() const { tabla->bloquear(pid); }
+};
+
+// Devuelve a la cola de listos de su planificador un proceso que se desbloquea (E/S, impresora).
+// Cada planificador tiene su propia tabla, asi que el dueño se reconoce por handle.tabla.
+using ReencolarProceso = std::function<void(HandleProceso)>;
+
+
+// ------------------------- Registro de eventos (traza) -------------------------
+// Niveles acumulativos: cada nivel incluye a los anteriores.
+enum class NivelTraza : uint8_t { OFF, RESUMEN, EVENTOS, TICKS };
+
+enum class TipoEvento : uint8_t {
+    RUN_RESUMEN, TERMINACION,
+    DESPACHO_RR, PREEMPCION_RR, SELECCION_SJF, PREEMPCION_SRTF,
+    EJECUCION_RR, EJECUCION_SJF, CPU_IDLE,
+    IO_SOLICITUD, IO_INICIO, IO_FIN,
+    MIGRACION,
+    SELECCION_CFS, PREEMPCION_CFS, EJECUCION_CFS,
+    IMPRESION_ENVIO, IMPRESION_BLOQUEO, IMPRESION_INICIO, IMPRESION_FIN, IMPRESION_LOTE, IMPRESION_DESPERTAR,
+    MEM_ACCESO, MEM_COW, MEM_COMPARTIDA, MEM_SUSPENSION, MEM_REANUDACION, MEM_RECONFIGURACION, DISCO_MOVIMIENTO,
+    SYNC_PRODUCIDO, SYNC_LLENO, SYNC_CONSUMIDO, SYNC_VACIO,
+    FILOSOFO
+};
+
+// Registro binario de tamano fijo; los textos (nombres de dispositivo, trabajos de
+// impresion) se guardan una vez en la tabla de textos y el registro lleva su indice.
+struct EventoTraza {
+    int32_t tick;     // instante del evento (o inicio del tramo)
+    int32_t tick_fin; // fin del tramo para ejecuciones agrupadas
+    int32_t pid;
+    int32_t a, b, c;  // datos propios de cada tipo
+    TipoEvento tipo;
+    int16_t nucleo;   // CPU simulada que genero el evento (-1 = monoprocesador)
+};
+
+
+class RegistroEventos {
+private:
+    static constexpr size_t CAPACIDAD = 1 << 16; // potencia de 2
+    std::vector<EventoTraza> anillo;
+    std::atomic<uint64_t> escritos{0}; // avanzado solo por el hilo de la simulacion
+    std::atomic<uint64_t> leidos{0};   // avanzado solo por el hilo escritor
+
+    NivelTraza nivel = NivelTraza::TICKS;
+    bool eco_consola = true;
+
+    // escritura asincrona a archivo
+    std::ofstream archivo;
+    std::string ruta_archivo;
+    std::thread escritor;
+    std::atomic<bool> archivo_activo{false};
+    std::atomic<bool> detener{false};
+    std::mutex mtx_escritor;
+    std::condition_variable cv_escritor;
+    uint64_t bloqueos_productor = 0;
+
+    mutable std::mutex mtx_textos;
+    std::vector<std::string> textos;
+    std::map<std::string, int> indice_textos;
+
+    void drenar() {
+        uint64_t hasta = escritos.load(std::memory_order_acquire);
+        uint64_t i = leidos.load(std::memory_order_relaxed);
+        for (; i < hasta; ++i) {
+            escribir(archivo, anillo[i & (CAPACIDAD - 1)]);
+            archivo << '\n';
+        }
+        leidos.store(i, std::memory_order_release);
+    }
+
+    void bucle_escritor() {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lk(mtx_escritor);
+                cv_escritor.wait_for(lk, std::chrono::milliseconds(10), [&] {
+                    return detener.load() ||
+                           escritos.load(std::memory_order_acquire) - leidos.load() >= CAPACIDAD / 2;
+                });
+            }
+            drenar();
+            if (detener.load()) break;
+        }
+        drenar();
+        archivo.flush();
+    }
+
+    static void etiqueta(std::ostream &os, int desde, int hasta) {
+        if (desde >= hasta) os << "[TICK " << desde << "]";
+        else os << "[TICK " << desde << ".." << hasta << "]";
+    }
+
+    static void cpu(std::ostream &os, const EventoTraza &e) {
+        if (e.nucleo >= 0) os << " CPU" << e.nucleo;
+    }
+
+public:
+    RegistroEventos() : anillo(CAPACIDAD) {}
+    ~RegistroEventos() { cerrar_archivo(); }
+    RegistroEventos(const RegistroEventos &) = delete;
+    RegistroEventos &operator=(const RegistroEventos &) = delete;
+
+    bool activo(NivelTraza n) const { return n <= nivel; }
+    NivelTraza get_nivel() const { return nivel; }
+    void set_nivel(NivelTraza n) { nivel = n; }
+    void set_eco_consola(bool on) { eco_consola = on; }
+
+    // Con el nivel en OFF (o por encima del evento) el costo es una comparacion
+    void emitir(NivelTraza n, TipoEvento tipo, int tick, int tick_fin, int pid, int a = 0, int b = 0, int c = 0,
+                int nucleo = -1) {
+        if (n > nivel) return;
+        EventoTraza ev{tick, tick_fin, pid, a, b, c, tipo, (int16_t)nucleo};
+        uint64_t i = escritos.load(std::memory_order_relaxed);
+        if (archivo_activo.load(std::memory_order_relaxed)) {
+            // anillo lleno: esperar al escritor en lugar de perder eventos del archivo
+            if (i - leidos.load(std::memory_order_acquire) >= CAPACIDAD) {
+                bloqueos_productor++;
+                cv_escritor.notify_one();
+                while (i - leidos.load(std::memory_order_acquire) >= CAPACIDAD) std::this_thread::yield();
+            }
+        }
+        anillo[i & (CAPACIDAD - 1)] = ev;
+        escritos.store(i + 1, std::memory_order_release);
+        if (archivo_activo.load(std::memory_order_relaxed) && i + 1 - leidos.load(std::memory_order_relaxed) == CAPACIDAD / 2)
+            cv_escritor.notify_one();
+        if (eco_consola) {
+            escribir(std::cout, ev);
+            std::cout << '\n';
+        }
+    }
+
+    int texto(const std::string &s) {
+        std::lock_guard<std::mutex> lk(mtx_textos);
+        auto it = indice_textos.find(s);
+        if (it != indice_textos.end()) return it->second;
+        textos.push_back(s);
+        return indice_textos[s] = (int)textos.size() - 1;
+    }
+
+    std::string obtener_texto(int id) const {
+        std::lock_guard<std::mutex> lk(mtx_textos);
+        return (id >= 0 && id < (int)textos.size()) ? textos[id] : std::string("?");
+    }
+
+    // Da formato a un registro con el mismo texto que imprimia cada subsistema
+    void escribir(std::ostream &os, const EventoTraza &e) const {
+        switch (e.tipo) {
+            case TipoEvento::RUN_RESUMEN:
+                os << "[RUN] " << (e.tick_fin - e.tick) << " ticks simulados en " << e.a
+                   << " pasos (t=" << e.tick << ".." << e.tick_fin << ")";
+                break;
+            case TipoEvento::TERMINACION:
+                os << "[EVENT]"; cpu(os, e);
+                os << " PID " << e.pid << " TERMINADO en tick " << e.tick;
+                break;
+            case TipoEvento::DESPACHO_RR:
+                os << "[TICK " << e.tick << "]"; cpu(os, e);
+                os << " Context switch -> PID " << e.pid;
+                break;
+            case TipoEvento::PREEMPCION_RR:
+                os << "[EVENT]"; cpu(os, e);
+                os << " Preempcion -> PID " << e.pid << " vuelve a cola LISTOS";
+                break;
+            case TipoEvento::SELECCION_SJF:
+                os << "[TICK " << e.tick << "]"; cpu(os, e);
+                os << " SJF selecciona PID " << e.pid;
+                break;
+            case TipoEvento::PREEMPCION_SRTF:
+                os << "[EVENT]"; cpu(os, e);
+                os << " Preempcion SRTF -> PID " << e.pid << " (restante=" << e.a << ") cede CPU a PID " << e.b;
+                break;
+            case TipoEvento::EJECUCION_RR:
+                etiqueta(os, e.tick, e.tick_fin); cpu(os, e);
+                os << " Ejecutando PID " << e.pid << " (restante=" << e.a << ", quantum_usado=" << e.b << ")";
+                if (e.c > 0) os << " [" << e.c << " quantums sin competencia]";
+                break;
+            case TipoEvento::EJECUCION_SJF:
+                etiqueta(os, e.tick, e.tick_fin); cpu(os, e);
+                os << " Ejecutando PID " << e.pid << " (restante=" << e.a << ")";
+                break;
+            case TipoEvento::CPU_IDLE:
+                etiqueta(os, e.tick, e.tick_fin);
+                os << (e.nucleo >= 0 ? " CPU" + std::to_string(e.nucleo) : std::string(" CPU")) << " IDLE";
+                break;
+            case TipoEvento::SELECCION_CFS:
+                os << "[TICK " << e.tick << "]"; cpu(os, e);
+                os << " CFS selecciona PID " << e.pid << " (vruntime=" << e.a << ", rebanada=" << e.b << ")";
+                break;
+            case TipoEvento::PREEMPCION_CFS:
+                os << "[EVENT]"; cpu(os, e);
+                os << " Preempcion CFS -> PID " << e.pid << " (vruntime=" << e.a << ") cede CPU a PID " << e.b;
+                break;
+            case TipoEvento::EJECUCION_CFS:
+                etiqueta(os, e.tick, e.tick_fin); cpu(os, e);
+                os << " Ejecutando PID " << e.pid << " (restante=" << e.a << ", vruntime=" << e.b << ")";
+                if (e.c > 0) os << " [" << e.c << " rebanadas sin competencia]";
+                break;
+            case TipoEvento::MIGRACION:
+                os << "[EVENT] CPU" << e.nucleo << " toma PID " << e.pid << " de la cola de CPU" << e.a;
+                break;
+            case TipoEvento::IO_SOLICITUD:
+                os << "[IO] PID " << e.pid << " solicita " << obtener_texto(e.a)
+                   << " (dur=" << e.b << ", prio=" << e.c << ")";
+                break;
+            case TipoEvento::IO_INICIO:
+                os << "[IO] " << obtener_texto(e.a) << " atendiendo PID " << e.pid;
+                break;
+            case TipoEvento::IO_FIN:
+                os << "[IO] PID " << e.pid << " termino en " << obtener_texto(e.a);
+                break;
+            case TipoEvento::IMPRESION_ENVIO:
+                os << "[IMPRESORA] Proceso " << e.pid << " envia trabajo: '" << obtener_texto(e.a) << "'";
+                break;
+            case TipoEvento::IMPRESION_BLOQUEO:
+                os << "[IMPRESORA] Cola llena. Proceso " << e.pid << " bloqueado (esperando turno)...";
+                break;
+            case TipoEvento::IMPRESION_INICIO:
+                os << "[IMPRESORA t=" << e.tick << "] Imprimiendo trabajo de PID " << e.pid << " -> \""
+                   << obtener_texto(e.a) << "\" (" << e.b << " ticks)";
+                break;
+            case TipoEvento::IMPRESION_FIN:
+                os << "[IMPRESORA t=" << e.tick << "] Trabajo de PID " << e.pid << " completado (latencia " << e.a
+                   << " ticks)";
+                break;
+            case TipoEvento::IMPRESION_LOTE:
+                os << "[IMPRESORA t=" << e.tick << "] Lote de " << e.a << " trabajos (" << e.b << " ticks con la preparacion)";
+                break;
+            case TipoEvento::IMPRESION_DESPERTAR:
+                os << "[IMPRESORA] Se libero un lugar: proceso " << e.pid << " despierta";
+                break;
+            case TipoEvento::MEM_ACCESO:
+                os << (e.b ? "[MEM] HIT " : "[MEM] MISS ") << " PID " << e.pid << " Pag " << e.a
+                   << " (tiempo_sim=" << e.c << " ticks)";
+                break;
+            case TipoEvento::MEM_COW:
+                os << "[MEM] COW   PID " << e.pid << " Pag " << e.a << " -> marco " << e.b
+                   << " (tiempo_sim=" << e.c << " ticks)";
+                break;
+            case TipoEvento::MEM_COMPARTIDA:
+                os << "[MEM] PID " << e.pid << " Pag " << e.a << " mapea el marco " << e.c << " del segmento "
+                   << e.b << " (fallo menor)";
+                break;
+            case TipoEvento::MEM_SUSPENSION:
+                os << "[MEM] PID " << e.pid << " suspendido (working set " << e.a << "): suma de working sets "
+                   << e.b << " > " << e.c << " marcos";
+                break;
+            case TipoEvento::MEM_REANUDACION:
+                os << "[MEM] PID " << e.pid << " reanudado (working set " << e.a << ", suma " << e.b << " de "
+                   << e.c << " marcos)";
+                break;
+            case TipoEvento::MEM_RECONFIGURACION:
+                os << "[MEM] Reconfiguracion: " << obtener_texto(e.a) << " (" << e.b << " paginas expulsadas)";
+                break;
+            case TipoEvento::DISCO_MOVIMIENTO:
+                os << "  Cabezal: " << e.a << " -> " << e.b << " (mov=" << e.c << ")";
+                break;
+            case TipoEvento::SYNC_PRODUCIDO:
+                os << "[SYNC] Producido " << e.a << " (buffer=" << e.b << ")";
+                break;
+            case TipoEvento::SYNC_LLENO:
+                os << "[SYNC] Buffer lleno: produccion bloqueada (simulado) ";
+                break;
+            case TipoEvento::SYNC_CONSUMIDO:
+                os << "[SYNC] Consumido " << e.a << " (restan=" << e.b << ")";
+                break;
+            case TipoEvento::SYNC_VACIO:
+                os << "[SYNC] Buffer vacio: consumo bloqueado (simulado)";
+                break;
+            case TipoEvento::FILOSOFO: {
+                static const char *acciones[] = {
+                    "Pensando...", "Intenta tomar tenedores", "Comiendo",
+                    "Termina de comer y suelta tenedores", "Bloqueado esperando tenedores..."
+                };
+                os << "[Filosofo " << e.pid << "] " << acciones[e.a];
+                break;
+            }
+        }
+    }
+
+    // Vuelca los ultimos n registros del anillo (los mas antiguos se sobrescriben)
+    void mostrar_ultimos(size_t n) const {
+        uint64_t fin = escritos.load(std::memory_order_relaxed);
+        uint64_t disponibles = std::min<uint64_t>(fin, CAPACIDAD);
+        uint64_t inicio = fin - std::min<uint64_t>(n, disponibles);
+        std::cout << "\n[LOG] Ultimos " << (fin - inicio) << " eventos del anillo:\n";
+        for (uint64_t i = inicio; i < fin; ++i) {
+            escribir(std::cout, anillo[i & (CAPACIDAD - 1)]);
+            std::cout << '\n';
+        }
+    }
+
+    bool abrir_archivo(const std::string &ruta) {
+        cerrar_archivo();
+        archivo.open(ruta);
+        if (!archivo) return false;
+        ruta_archivo = ruta;
+        leidos.store(escritos.load());
+        detener = false;
+        archivo_activo = true;
+        escritor = std::thread(&RegistroEventos::bucle_escritor, this);
+        return true;
+    }
+
+    void cerrar_archivo() {
+        if (!archivo_activo) return;
+        detener = true;
+        cv_escritor.notify_one();
+        escritor.join();
+        archivo_activo = false;
+        archivo.close();
+    }
+
+    void mostrar_estado() const {
+        static const char *niveles[] = {"off", "resumen", "eventos", "ticks"};
+        std::cout << "[LOG] Nivel: " << niveles[(int)nivel]
+             << " | Consola: " << (eco_consola ? "on" : "off")
+             << " | Eventos registrados: " << escritos.load()
+             << " | Anillo: " << CAPACIDAD << " registros de " << sizeof(EventoTraza) << " bytes\n";
+        if (archivo_activo)
+            std::cout << "[LOG] Archivo: " << ruta_archivo << " | Escritos: " << leidos.load()
+                 << " | Esperas por anillo lleno: " << bloqueos_productor << "\n";
+        else
+            std::cout << "[LOG] Archivo: (ninguno)\n";
+    }
+};
+
+
+// Emite solo si el subsistema tiene un registro asociado
+inline void emitir(RegistroEventos *traza, NivelTraza n, TipoEvento tipo, int tick, int tick_fin, int pid,
+                   int a = 0, int b = 0, int c = 0, int nucleo = -1) {
+    if (traza) traza->emitir(n, tipo, tick, tick_fin, pid, a, b, c, nucleo);
+}
+
+
+// ------------------------- FrameManager + Tablas de páginas -------------------------
+struct Frame {
+    int pid = -1;
+    int pagina = -1;
+    long long last_used = 0; // para LRU
+    // lista de recencia intrusiva (marcos ocupados, del menos al mas reciente)
+    int anterior = -1;
+    int siguiente = -1;
+    // lista de marcos del mismo proceso (indice inverso pid -> marcos)
+    int anterior_proceso = -1;
+    int siguiente_proceso = -1;
+};
+
+
+// Segmento compartido mapeado en las paginas base..base+paginas-1 de un proceso
+struct MapeoSegmento {
+    int segmento;
+    int base;
+    int paginas;
+};
+
+// Contadores de memoria de un proceso: se actualizan en cada acceso, memstats los lee en O(1)
+struct MemoriaProceso {
+    int primer_marco = -1;     // cabeza de su lista de marcos
+    int residentes = 0;
+    long long accesos = 0;
+    long long fallos = 0;
+    long long reemplazadas = 0; // paginas suyas expulsadas por la politica
+
+    // Working Set (politica WS): sus ultimas 'ventana' referencias y cuantas veces aparece
+    // cada pagina en ellas; el working set es conteo.size()
+    std::deque<int> ventana;
+    std::unordered_map<int, int> conteo;
+    int cuota = 0;                  // marcos asignados por el control PFF
+    long long acceso_ultimo_fallo = 0;
+    bool suspendido = false;
+    int suspensiones = 0;
+
+    // Paginas mapeadas en marcos cuyo dueño es otro proceso (fork, segmentos): pagina -> marco
+    std::unordered_map<int, int> compartidas;
+    std::vector<MapeoSegmento> segmentos;
+    long long fallos_cow = 0;
+};
+
+// Los pids indexan arreglos por proceso: GestorMarcos ignora los accesos con pid negativo o
+// mayor y las trazas (memload) los cuentan como ignorados
+constexpr uint32_t MAX_PID_TRAZA = 1u << 22;
+
+// Estado de memoria indexado por PID, en paginas de PAGINA entradas que se reservan al
+// primer uso: un PID alto (trazas) cuesta un puntero por pagina del directorio y una sola
+// pagina, no un MemoriaProceso por cada PID menor. Las entradas no se mueven al crecer.
+class DirectorioMemoria {
+private:
+    static constexpr int PAGINA = 256;
+    std::vector<std::unique_ptr<MemoriaProceso[]>> paginas;
+
+public:
+    MemoriaProceso &operator[](int pid) {
+        size_t d = (size_t)pid / PAGINA;
+        if (d >= paginas.size()) paginas.resize(d + 1);
+        if (!paginas[d]) paginas[d].reset(new MemoriaProceso[PAGINA]);
+        return paginas[d][pid % PAGINA];
+    }
+
+    // nullptr si la pagina del PID nunca se reservo
+    const MemoriaProceso *buscar(int pid) const {
+        if (pid < 0 || (size_t)pid / PAGINA >= paginas.size() || !paginas[pid / PAGINA]) return nullptr;
+        return &paginas[pid / PAGINA][pid % PAGINA];
+    }
+    MemoriaProceso *buscar(int pid) {
+        return const_cast<MemoriaProceso *>(static_cast<const DirectorioMemoria &>(*this).buscar(pid));
+    }
+
+    // f(pid, memoria) para cada entrada de las paginas reservadas
+    template <class F> void para_cada(F &&f) {
+        for (size_t d = 0; d < paginas.size(); ++d)
+            if (paginas[d])
+                for (int k = 0; k < PAGINA; ++k) f((int)(d * PAGINA) + k, paginas[d][k]);
+    }
+};
+
+
+// Tabla de paginas plana: hash de direccionamiento abierto (sondeo lineal) de (pid, pagina)
+// a marco. Solo guarda paginas residentes: sin marcos compartidos nunca tiene mas entradas
+// que marcos y la capacidad inicial (potencia de 2, >= 2x marcos) alcanza; los mapeos
+// compartidos (fork, segmentos) pueden superarla y la tabla se duplica para mantener el
+// factor de carga <= 0.5. El borrado desplaza hacia atras las entradas del mismo grupo: sin lapidas.
+class TablaPaginasPlana {
+private:
+    struct Entrada {
+        uint64_t clave;
+        int marco = -1; // -1 = vacia
+    };
+    std::vector<Entrada> entradas;
+    size_t mascara;
+    size_t ocupadas = 0;
+
+    static uint64_t clave_de(int pid, int pagina) {
+        return ((uint64_t)(uint32_t)pid << 32) | (uint32_t)pagina;
+    }
+
+    // mezcla de splitmix64: pids y paginas consecutivos quedan dispersos
+    static uint64_t dispersar(uint64_t x) {
+        x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    void crecer() {
+        std::vector<Entrada> viejas;
+        viejas.swap(entradas);
+        entradas.assign(viejas.size() * 2, Entrada());
+        mascara = entradas.size() - 1;
+        for (const Entrada &e : viejas) {
+            if (e.marco < 0) continue;
+            size_t i = dispersar(e.clave) & mascara;
+            while (entradas[i].marco >= 0) i = (i + 1) & mascara;
+            entradas[i] = e;
+        }
+    }
+
+public:
+    explicit TablaPaginasPlana(int max_entradas = 0) {
+        size_t cap = 16;
+        while (cap < 2 * (size_t)std::max(0, max_entradas)) cap <<= 1;
+        entradas.assign(cap, Entrada());
+        mascara = cap - 1;
+    }
+
+    // marco donde reside (pid, pagina) o -1
+    int buscar(int pid, int pagina) const {
+        uint64_t c = clave_de(pid, pagina);
+        for (size_t i = dispersar(c) & mascara;; i = (i + 1) & mascara) {
+            const Entrada &e = entradas[i];
+            if (e.marco < 0) return -1;
+            if (e.clave == c) return e.marco;
+        }
+    }
+
+    void insertar(int pid, int pagina, int marco) {
+        uint64_t c = clave_de(pid, pagina);
+        size_t i = dispersar(c) & mascara;
+        while (entradas[i].marco >= 0 && entradas[i].clave != c) i = (i + 1) & mascara;
+        if (entradas[i].marco < 0 && ++ocupadas * 2 > entradas.size()) {
+            crecer();
+            i = dispersar(c) & mascara;
+            while (entradas[i].marco >= 0) i = (i + 1) & mascara;
+        }
+        entradas[i] = {c, marco};
+    }
+
+    void borrar(int pid, int pagina) {
+        uint64_t c = clave_de(pid, pagina);
+        size_t i = dispersar(c) & mascara;
+        while (entradas[i].marco >= 0 && entradas[i].clave != c) i = (i + 1) & mascara;
+        if (entradas[i].marco < 0) return;
+        ocupadas--;
+        // desplazamiento hacia atras: cada entrada siguiente del grupo que pueda ocupar
+        // el hueco (su posicion ideal no esta entre el hueco y ella) se mueve ahi
+        size_t hueco = i;
+        for (size_t j = (i + 1) & mascara; entradas[j].marco >= 0; j = (j + 1) & mascara) {
+            size_t ideal = dispersar(entradas[j].clave) & mascara;
+            if (((j - ideal) & mascara) >= ((j - hueco) & mascara)) {
+                entradas[hueco] = entradas[j];
+                hueco = j;
+            }
+        }
+        entradas[hueco].marco = -1;
+    }
+};
+
+
+struct AccesoRegistro {
+    long long tick;
+    int pid;
+    int pagina;
+    bool hit;
+    bool escritura;
+    int tiempo_acceso_simulado; // ticks consumidos por el acceso
+};
+
+
+// ------------------------- Traza de accesos a memoria -------------------------
+// Dos niveles con memoria acotada:
+//  - un anillo de tamaño fijo con los ultimos accesos (memtrace, memview);
+//  - opcionalmente, la traza completa en un archivo columnar comprimido que se
+//    escribe por bloques a traves de una ventana mmap, sin crecer en RAM.
+// Formato del archivo: CabeceraTrazaAccesos y luego bloques independientes, cada uno
+//   CabeceraBloqueAccesos, diccionario de pids (varint) y 4 columnas:
+//   tick     zigzag varint del delta con el acceso anterior del bloque
+//   pid      varint del indice en el diccionario del bloque
+//   pagina   zigzag varint del delta con la pagina anterior del mismo pid
+//   result   varint de (tiempo << 2 | escritura << 1 | hit)
+struct CabeceraTrazaAccesos {
+    char magia[4];          // "SOTA"
+    uint32_t version;
+    uint64_t n_accesos;
+    uint64_t n_bloques;
+};
+
+struct CabeceraBloqueAccesos {
+    uint32_t n_accesos;
+    uint32_t n_pids;
+    uint32_t bytes[5]; // diccionario, tick, pid, pagina, resultado
+};
+
+inline void poner_varint(std::vector<uint8_t> &v, uint64_t x) {
+    while (x >= 0x80) { v.push_back((uint8_t)(x | 0x80)); x >>= 7; }
+    v.push_back((uint8_t)x);
+}
+
+// Lee un varint sin pasar de 'fin' (fin de la columna). false si la columna se corta o el
+// varint tiene mas de 10 bytes (no cabe en 64 bits): archivo truncado o corrupto.
+inline bool leer_varint(const uint8_t *&p, const uint8_t *fin, uint64_t &x) {
+    x = 0;
+    for (int s = 0; s < 70 && p < fin; s += 7) {
+        uint8_t b = *p++;
+        x |= (uint64_t)(b & 0x7f) << s;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+inline uint64_t zigzag(int64_t x) { return ((uint64_t)x << 1) ^ (uint64_t)(x >> 63); }
+inline int64_t deszigzag(uint64_t x) { return (int64_t)(x >> 1) ^ -(int64_t)(x & 1); }
+
+
+class TrazaAccesos {
+private:
+    static constexpr size_t CAPACIDAD_ANILLO = 1 << 12; // potencia de 2
+    static constexpr uint32_t ACCESOS_POR_BLOQUE = 1 << 16;
+
+    std::vector<AccesoRegistro> anillo;
+    uint64_t escritos = 0;
+    bool activo = true;
+
+    // traza completa: columnas del bloque en curso y archivo de destino
+    int fd = -1;
+    std::string ruta_archivo;
+    uint64_t bytes_archivo = 0;
+    uint64_t accesos_archivo = 0;
+    uint64_t bloques_archivo = 0;
+    std::vector<uint8_t> col_dic, col_tick, col_pid, col_pagina, col_resultado;
+    uint32_t en_bloque = 0;
+    long long tick_anterior = 0;
+    // diccionario del bloque: indice por pid, validado con el numero de bloque
+    std::vector<uint32_t> dic_indice, dic_bloque;
+    std::vector<int> pagina_anterior; // por indice del diccionario
+
+    void agregar_columnas(const AccesoRegistro &r);
+    void volcar_bloque();
+    void escribir_archivo(uint64_t offset, const void *datos, size_t n);
+
+public:
+    TrazaAccesos() : anillo(CAPACIDAD_ANILLO) {}
+    ~TrazaAccesos() { cerrar_archivo(); }
+    TrazaAccesos(const TrazaAccesos &) = delete;
+    TrazaAccesos &operator=(const TrazaAccesos &) = delete;
+
+    // Apagada, cada acceso cuesta una comparacion y no se guarda nada
+    void registrar(long long tick, int pid, int pagina, bool hit, bool escritura, int tiempo) {
+        if (!activo) return;
+        AccesoRegistro r{tick, pid, pagina, hit, escritura, tiempo};
+        anillo[escritos++ & (CAPACIDAD_ANILLO - 1)] = r;
+        if (fd >= 0) agregar_columnas(r);
+    }
+
+    bool get_activo() const { return activo; }
+    void set_activo(bool on) { activo = on; }
+    void limpiar_anillo() { escritos = 0; }
+
+    size_t capacidad_anillo() const { return CAPACIDAD_ANILLO; }
+    size_t en_anillo() const { return (size_t)std::min<uint64_t>(escritos, CAPACIDAD_ANILLO); }
+    // i = 0 es el mas reciente
+    const AccesoRegistro &reciente(size_t i) const { return anillo[(escritos - 1 - i) & (CAPACIDAD_ANILLO - 1)]; }
+    // true si el anillo ya descarto accesos
+    bool anillo_truncado() const { return escritos > CAPACIDAD_ANILLO; }
+
+    bool abrir_archivo(const std::string &ruta);
+    void cerrar_archivo();
+    bool archivo_activo() const { return fd >= 0; }
+    const std::string &get_ruta_archivo() const { return ruta_archivo; }
+    uint64_t get_accesos_archivo() const { return accesos_archivo + en_bloque; }
+    uint64_t get_bytes_archivo() const { return bytes_archivo; }
+
+    void mostrar_estado() const;
+
+    // Secuencia pid << 32 | pagina: del archivo si hay traza completa, si no del anillo
+    std::vector<uint64_t> referencias();
+    // Agrega a 'out' las referencias de un archivo escrito por esta clase; false si no es valido
+    static bool leer_referencias(const std::string &ruta, std::vector<uint64_t> &out);
+};
+
+
+// Politicas de reemplazo. CLOCK, SEGUNDA_OPORTUNIDAD (mejorada, con bit de sucio) y
+// AGING aproximan LRU con bits de referencia en lugar de reordenar en cada acierto.
+enum class PoliticaMemoria : uint8_t { FIFO, LRU, WS, CLOCK, SEGUNDA_OPORTUNIDAD, AGING };
+
+const char *nombre_politica(PoliticaMemoria p);
+// "fifo", "lru", "ws", "clock", "sc" o "aging"; false si no es ninguna
+bool politica_desde_texto(const std::string &s, PoliticaMemoria &p);
+
+
+// ------------------------- TLB -------------------------
+// Cache de traducciones (pid, pagina) -> marco delante de la tabla de paginas.
+// Conjuntos indexados por los bits bajos de la pagina; cada entrada lleva el pid como
+// etiqueta. Sin ASID el cambio de contexto vacia el TLB; con ASID las entradas sobreviven.
+enum class ReemplazoTLB : uint8_t { LRU, ALEATORIO };
+
+struct ConfigTLB {
+    int entradas = 0;      // 0 = sin TLB
+    int asociatividad = 4; // vias por conjunto; igual a entradas = totalmente asociativo
+    ReemplazoTLB reemplazo = ReemplazoTLB::LRU;
+    bool asid = false;
+};
+
+class TLB {
+private:
+    static constexpr uint64_t VACIA = ~0ULL;
+    ConfigTLB cfg;
+    int conjuntos;
+    std::vector<uint64_t> clave; // pid << 32 | pagina, conjunto i en [i*vias, (i+1)*vias)
+    std::vector<int> marco;
+    std::vector<uint32_t> uso;   // LRU: instante del ultimo uso dentro del TLB
+    uint32_t reloj = 0;
+    uint64_t semilla = 0x9e3779b97f4a7c15ULL;
+
+    size_t base(int pagina) const { return (size_t)((uint32_t)pagina % (uint32_t)conjuntos) * cfg.asociatividad; }
+
+public:
+    long long aciertos = 0, fallos = 0, vaciados = 0, invalidaciones = 0;
+
+    explicit TLB(ConfigTLB c = ConfigTLB()) : cfg(c) {
+        if (cfg.entradas <= 0) { cfg.entradas = 0; conjuntos = 1; return; }
+        cfg.asociatividad = std::max(1, std::min(cfg.asociatividad, cfg.entradas));
+        conjuntos = cfg.entradas / cfg.asociatividad;
+        cfg.entradas = conjuntos * cfg.asociatividad;
+        clave.assign(cfg.entradas, VACIA);
+        marco.assign(cfg.entradas, -1);
+        uso.assign(cfg.entradas, 0);
+    }
+
+    bool activo() const { return cfg.entradas > 0; }
+    const ConfigTLB &config() const { return cfg; }
+
+    // marco de (pid, pagina) o -1; cuenta el acierto o el fallo
+    int buscar(int pid, int pagina) {
+        uint64_t c = ((uint64_t)(uint32_t)pid << 32) | (uint32_t)pagina;
+        size_t b = base(pagina);
+        for (int v = 0; v < cfg.asociatividad; ++v) {
+            if (clave[b + v] == c) {
+                aciertos++;
+                uso[b + v] = ++reloj;
+                return marco[b + v];
+            }
+        }
+        fallos++;
+        return -1;
+    }
+
+    // Tras recorrer la tabla: ocupa una via libre o reemplaza segun la politica
+    void insertar(int pid, int pagina, int m) {
+        size_t b = base(pagina);
+        size_t elegido = SIZE_MAX;
+        for (int v = 0; v < cfg.asociatividad && elegido == SIZE_MAX; ++v)
+            if (clave[b + v] == VACIA) elegido = b + v;
+        if (elegido == SIZE_MAX && cfg.reemplazo == ReemplazoTLB::ALEATORIO) {
+            semilla ^= semilla << 13; semilla ^= semilla >> 7; semilla ^= semilla << 17;
+            elegido = b + semilla % cfg.asociatividad;
+        } else if (elegido == SIZE_MAX) {
+            elegido = b;
+            for (int v = 1; v < cfg.asociatividad; ++v)
+                if (uso[b + v] < uso[elegido]) elegido = b + v;
+        }
+        clave[elegido] = ((uint64_t)(uint32_t)pid << 32) | (uint32_t)pagina;
+        marco[elegido] = m;
+        uso[elegido] = ++reloj;
+    }
+
+    // La pagina dejo su marco (reemplazo o fin del proceso)
+    void invalidar(int pid, int pagina) {
+        uint64_t c = ((uint64_t)(uint32_t)pid << 32) | (uint32_t)pagina;
+        size_t b = base(pagina);
+        for (int v = 0; v < cfg.asociatividad; ++v)
+            if (clave[b + v] == c) { clave[b + v] = VACIA; invalidaciones++; return; }
+    }
+
+    // Otro proceso toma la CPU
+    void cambio_contexto() {
+        if (cfg.asid || !activo()) return;
+        std::fill(clave.begin(), clave.end(), VACIA);
+        vaciados++;
+    }
+
+    double tasa_aciertos() const { return aciertos + fallos ? (double)aciertos / (aciertos + fallos) : 0.0; }
+};
+
+
+// ------------------------ Gestor de Marcos (Working Set) ---------------------------- //
+class GestorMarcos {
+private:
+    std::vector<Frame> marcos;
+    std::deque<int> cola_fifo;
+    int max_marcos;
+    int marcos_ocupados;
+    // mapa de bits de marcos libres (1 = libre) y primera palabra que puede tener alguno
+    std::vector<uint64_t> libres;
+    size_t palabra_libre;
+    DirectorioMemoria por_proceso; // indexado por PID
+    int lru_cabeza; // menos reciente (victima LRU)
+    int lru_cola;   // mas reciente
+    long long reloj_tick;
+    long long accesos_totales;
+    long long fallos_totales;
+    long long escrituras_disco; // paginas sucias expulsadas (write-back)
+    TrazaAccesos *registro_accesos; // anillo + traza completa; nullptr = sin registro
+
+    PoliticaMemoria politica;
+    int ventana_ws; // tamaño de la ventana Working Set; en AGING, accesos entre envejecimientos
+    RegistroEventos *traza;
+
+    // Bits empaquetados por marco (64 por palabra): la manecilla del reloj salta palabras
+    // enteras y el envejecimiento recorre arreglos contiguos que el compilador vectoriza.
+    std::vector<uint64_t> bits_referencia;
+    std::vector<uint64_t> bits_sucio;
+    std::vector<uint8_t> contador_edad; // AGING: bit mas alto = referenciada en el ultimo periodo
+    int manecilla;
+
+    TablaPaginasPlana tabla_paginas;
+    TLB tlb;
+    long long recorridos;   // fallos de TLB resueltos en la tabla de paginas
+    long long ticks_fallos; // incluye los write-back de paginas sucias
+
+    // Control de carga (WS): suma de los working sets de los procesos no suspendidos,
+    // suspendidos en orden de llegada y cambios pendientes de aplicar en el planificador
+    long long suma_ws;
+    std::deque<int> cola_suspendidos;
+    std::vector<int> cambios_suspension;
+    long long suspensiones;
+    long long reanudaciones;
+
+    // Reconfiguraciones en linea (memmode) y contadores al momento de la ultima, para medir
+    // el pico de fallos que le sigue
+    int reconfiguraciones;
+    long long accesos_reconfig;
+    long long fallos_reconfig;
+    long long tick_reconfig;
+
+    // Marcos compartidos: el dueño es el de Frame y los demas mapeos van aparte (la cuenta de
+    // referencias de un marco es 1 + mapeos_extra). Un bit en bits_cow deja al marco de solo
+    // lectura: escribirlo es un fallo copy-on-write.
+    struct SegmentoCompartido {
+        int paginas = 0;
+        int procesos = 0;                // procesos que lo mapean
+        std::unordered_map<int, int> marcos;  // pagina del segmento -> marco residente
+    };
+    std::unordered_map<int, std::vector<std::pair<int, int>>> mapeos_extra; // marco -> (pid, pagina)
+    std::vector<uint64_t> bits_cow;
+    std::map<int, SegmentoCompartido> segmentos;
+    std::unordered_map<int, std::pair<int, int>> marco_segmento;       // marco -> (segmento, pagina del segmento)
+    long long forks;
+    long long fallos_cow;     // escrituras sobre paginas copy-on-write
+    long long copias_cow;     // las que copiaron el marco (el resto era el ultimo mapeo)
+    long long fallos_menores; // pagina de segmento ya residente por otro proceso
+
+    void desenlazar(int i) {
+        Frame &f = marcos[i];
+        if (f.anterior >= 0) marcos[f.anterior].siguiente = f.siguiente;
+        else lru_cabeza = f.siguiente;
+        if (f.siguiente >= 0) marcos[f.siguiente].anterior = f.anterior;
+        else lru_cola = f.anterior;
+        f.anterior = f.siguiente = -1;
+    }
+
+    void enlazar_al_final(int i) {
+        Frame &f = marcos[i];
+        f.anterior = lru_cola;
+        f.siguiente = -1;
+        if (lru_cola >= 0) marcos[lru_cola].siguiente = i;
+        else lru_cabeza = i;
+        lru_cola = i;
+    }
+
+    // Los eventos guardan ticks de 32 bits: el reloj de accesos se satura al pasarlos
+    int tick_traza() const { return (int)std::min<long long>(reloj_tick, INT_MAX); }
+
+    MemoriaProceso &memoria_de(int pid) {
+        return por_proceso[pid];
+    }
+
+    void agregar_a_proceso(MemoriaProceso &mp, int i) {
+        Frame &f = marcos[i];
+        f.anterior_proceso = -1;
+        f.siguiente_proceso = mp.primer_marco;
+        if (mp.primer_marco >= 0) marcos[mp.primer_marco].anterior_proceso = i;
+        mp.primer_marco = i;
+        mp.residentes++;
+    }
+
+    void quitar_de_proceso(MemoriaProceso &mp, int i) {
+        Frame &f = marcos[i];
+        if (f.anterior_proceso >= 0) marcos[f.anterior_proceso].siguiente_proceso = f.siguiente_proceso;
+        else mp.primer_marco = f.siguiente_proceso;
+        if (f.siguiente_proceso >= 0) marcos[f.siguiente_proceso].anterior_proceso = f.anterior_proceso;
+        f.anterior_proceso = f.siguiente_proceso = -1;
+        mp.residentes--;
+    }
+
+    // Marco libre de menor indice (find-first-set por palabras de 64 bits) o -1
+    int tomar_marco_libre() {
+        while (palabra_libre < libres.size() && libres[palabra_libre] == 0) palabra_libre++;
+        if (palabra_libre == libres.size()) return -1;
+        uint64_t &w = libres[palabra_libre];
+        int bit = __builtin_ctzll(w);
+        w &= w - 1;
+        return (int)(palabra_libre * 64 + bit);
+    }
+
+    void devolver_marco_libre(int i) {
+        libres[i / 64] |= 1ULL << (i % 64);
+        palabra_libre = std::min(palabra_libre, (size_t)i / 64);
+    }
+
+    static bool bit(const std::vector<uint64_t> &v, int i) { return (v[i / 64] >> (i % 64)) & 1; }
+    static void poner_bit(std::vector<uint64_t> &v, int i) { v[i / 64] |= 1ULL << (i % 64); }
+    static void quitar_bit(std::vector<uint64_t> &v, int i) { v[i / 64] &= ~(1ULL << (i % 64)); }
+
+    // Marcos ocupados de la palabra w (con la memoria llena, todos los del rango)
+    uint64_t marcos_validos(size_t w) const {
+        uint64_t ocupados = ~libres[w];
+        if (w + 1 == libres.size() && max_marcos % 64) return ocupados & ((1ULL << (max_marcos % 64)) - 1);
+        return ocupados;
+    }
+
+    // Primer marco, en orden circular desde la manecilla, cuyo bit en candidatos(w) vale 1.
+    // Con limpiar_ref, los marcos que la manecilla pasa de largo pierden su bit de referencia
+    // (la "segunda oportunidad"). Devuelve -1 tras una vuelta completa sin candidatos.
+    template <typename F>
+    int buscar_desde_manecilla(F candidatos, bool limpiar_ref) {
+        size_t nw = libres.size(), w0 = manecilla / 64;
+        int b0 = manecilla % 64;
+        for (size_t k = 0; k <= nw; ++k) {
+            size_t w = (w0 + k) % nw;
+            uint64_t rango = k == 0 ? ~0ULL << b0 : k == nw ? (1ULL << b0) - 1 : ~0ULL;
+            rango &= marcos_validos(w);
+            uint64_t c = candidatos(w) & rango;
+            if (c) {
+                int b = __builtin_ctzll(c);
+                if (limpiar_ref) bits_referencia[w] &= ~(rango & ((1ULL << b) - 1));
+                return (int)(w * 64 + b);
+            }
+            if (limpiar_ref) bits_referencia[w] &= ~rango;
+        }
+        return -1;
+    }
+
+    int victima_clock() {
+        auto sin_referencia = [&](size_t w) { return ~bits_referencia[w]; };
+        int v = buscar_desde_manecilla(sin_referencia, true);
+        // todas tenian el bit en 1: ya se limpiaron en la vuelta, cae la de la manecilla
+        if (v < 0) v = buscar_desde_manecilla(sin_referencia, false);
+        return v;
+    }
+
+    // Segunda oportunidad mejorada: clases (R,D) = (0,0) mejor, luego (0,1) limpiando R al pasar.
+    // Tras una vuelta sin (0,1) todas quedan con R=0 y la segunda ronda siempre encuentra.
+    int victima_segunda_oportunidad() {
+        for (int ronda = 0; ronda < 2; ++ronda) {
+            int v = buscar_desde_manecilla([&](size_t w) { return ~bits_referencia[w] & ~bits_sucio[w]; }, false);
+            if (v >= 0) return v;
+            v = buscar_desde_manecilla([&](size_t w) { return ~bits_referencia[w] & bits_sucio[w]; }, true);
+            if (v >= 0) return v;
+        }
+        return manecilla;
+    }
+
+    // AGING: desplaza todos los contadores y mete el bit de referencia como bit mas alto.
+    // SWAR: 8 contadores por palabra de 64 bits; cada byte del mapa de referencia se expande
+    // con una tabla a la mascara 0x80/0x00 de esos 8 contadores.
+    void envejecer() {
+        static const auto EXPANDIR = [] {
+            std::array<uint64_t, 256> t{};
+            for (int v = 0; v < 256; ++v)
+                for (int b = 0; b < 8; ++b)
+                    if (v >> b & 1) t[v] |= 0x80ULL << (8 * b);
+            return t;
+        }();
+        uint8_t *c = contador_edad.data(); // relleno hasta multiplo de 64
+        for (size_t w = 0; w < bits_referencia.size(); ++w) {
+            uint64_t r = bits_referencia[w];
+            bits_referencia[w] = 0;
+            for (int j = 0; j < 8; ++j, r >>= 8, c += 8) {
+                uint64_t v;
+                memcpy(&v, c, 8);
+                v = ((v >> 1) & 0x7F7F7F7F7F7F7F7FULL) | EXPANDIR[r & 0xFF];
+                memcpy(c, &v, 8);
+            }
+        }
+    }
+
+    // AGING: menor contador entre los marcos marcados en 'candidatos' de la palabra w, o 0x100
+    // si no hay ninguno. Los demas se rellenan con 0xFF (tabla byte -> mascara de 8 contadores)
+    // y el minimo por bytes queda en un bucle sin saltos que el compilador vectoriza.
+    unsigned minimo_edad(size_t w, uint64_t candidatos) const {
+        static const auto RELLENO = [] {
+            std::array<uint64_t, 256> t{};
+            for (int v = 0; v < 256; ++v)
+                for (int b = 0; b < 8; ++b)
+                    if (v >> b & 1) t[v] |= 0xFFULL << (8 * b);
+            return t;
+        }();
+        const uint8_t *c = contador_edad.data() + w * 64;
+        uint8_t k[64];
+        for (int j = 0; j < 8; ++j) {
+            uint64_t v;
+            memcpy(&v, c + 8 * j, 8);
+            v |= RELLENO[~candidatos >> (8 * j) & 0xFF];
+            memcpy(k + 8 * j, &v, 8);
+        }
+        uint8_t m = 0xFF;
+        for (int b = 0; b < 64; ++b) m = std::min(m, k[b]);
+        return m | (unsigned)(candidatos == 0) << 8;
+    }
+
+    // Menor contador; a igualdad, una no referenciada desde el ultimo envejecimiento y luego
+    // la de menor indice. Una pasada sobre los contadores (sin tocar los Frame) que lleva dos
+    // minimos, el de las no referenciadas y el de las referenciadas; solo la palabra ganadora
+    // se vuelve a mirar para ubicar el marco.
+    int victima_aging() const {
+        unsigned mejor[2] = {0x100, 0x100}; // [0] no referenciadas, [1] referenciadas
+        size_t palabra[2] = {0, 0};
+        for (size_t w = 0; w < libres.size(); ++w) {
+            uint64_t ocupados = marcos_validos(w), r = bits_referencia[w];
+            const uint64_t grupo[2] = {ocupados & ~r, ocupados & r};
+            for (int g = 0; g < 2; ++g) {
+                unsigned m = minimo_edad(w, grupo[g]);
+                palabra[g] = m < mejor[g] ? w : palabra[g];
+                mejor[g] = std::min(mejor[g], m);
+            }
+        }
+        int g = mejor[0] <= mejor[1] ? 0 : 1;
+        if (mejor[g] > 0xFF) return -1; // ningun marco ocupado
+        size_t w = palabra[g];
+        uint64_t ocupados = marcos_validos(w), r = bits_referencia[w];
+        uint64_t candidatos = g ? ocupados & r : ocupados & ~r;
+        const uint8_t *c = contador_edad.data() + w * 64;
+        int b = 0;
+        while (!(candidatos >> b & 1) || c[b] != mejor[g]) ++b;
+        return (int)(w * 64) + b;
+    }
+
+    // Victima de la politica activa entre los marcos ocupados. En el camino de un fallo solo
+    // se llama con la memoria llena; al achicar la memoria (reconfigurar) puede haber libres.
+    int elegir_victima() {
+        int elegido;
+        if (politica == PoliticaMemoria::LRU) {
+            // LRU: la cabeza de la lista de recencia, O(1)
+            elegido = lru_cabeza;
+        } else if (politica == PoliticaMemoria::WS) {
+            // la menos reciente fuera del working set de su proceso
+            for (elegido = lru_cabeza; elegido >= 0; elegido = marcos[elegido].siguiente) {
+                const Frame &f = marcos[elegido];
+                if (!por_proceso[f.pid].conteo.count(f.pagina)) return elegido;
+            }
+            elegido = lru_cabeza;
+        } else if (politica == PoliticaMemoria::CLOCK) {
+            elegido = victima_clock();
+            manecilla = (elegido + 1) % max_marcos;
+        } else if (politica == PoliticaMemoria::SEGUNDA_OPORTUNIDAD) {
+            elegido = victima_segunda_oportunidad();
+            manecilla = (elegido + 1) % max_marcos;
+        } else if (politica == PoliticaMemoria::AGING) {
+            elegido = victima_aging();
+        } else {
+            // FIFO
+            do {
+                elegido = cola_fifo.front();
+                cola_fifo.pop_front();
+                cola_fifo.push_back(elegido);
+            } while (marcos[elegido].pid == -1);
+        }
+        return elegido;
+    }
+
+    // ----- Marcos compartidos -----
+    // Quita los mapeos de otros procesos sobre el marco i (la expulsion les saca la pagina a
+    // todos), su vinculo con un segmento y la proteccion copy-on-write
+    void soltar_compartidos(int i) {
+        quitar_bit(bits_cow, i);
+        if (mapeos_extra.empty() && marco_segmento.empty()) return;
+        auto it = mapeos_extra.find(i);
+        if (it != mapeos_extra.end()) {
+            for (auto [q, pg] : it->second) {
+                tabla_paginas.borrar(q, pg);
+                if (tlb.activo()) tlb.invalidar(q, pg);
+                MemoriaProceso &mq = por_proceso[q];
+                mq.compartidas.erase(pg);
+                mq.reemplazadas++;
+            }
+            mapeos_extra.erase(it);
+        }
+        auto s = marco_segmento.find(i);
+        if (s != marco_segmento.end()) {
+            segmentos[s->second.first].marcos.erase(s->second.second);
+            marco_segmento.erase(s);
+        }
+    }
+
+    void mapear_extra(int i, int pid, int pagina) {
+        mapeos_extra[i].push_back({pid, pagina});
+        por_proceso[pid].compartidas[pagina] = i;
+        tabla_paginas.insertar(pid, pagina, i);
+    }
+
+    // Quita solo el mapeo (pid, pagina) del marco i. Si era el ultimo el marco queda libre;
+    // si era el del dueño, otro proceso que lo comparte pasa a serlo.
+    void quitar_mapeo(int pid, int pagina, int i, bool write_back) {
+        auto it = mapeos_extra.empty() ? mapeos_extra.end() : mapeos_extra.find(i);
+        if (it == mapeos_extra.end()) {
+            expulsar(i, write_back);
+            return;
+        }
+        tabla_paginas.borrar(pid, pagina);
+        if (tlb.activo()) tlb.invalidar(pid, pagina);
+        std::vector<std::pair<int, int>> &v = it->second;
+        if (marcos[i].pid == pid && marcos[i].pagina == pagina) {
+            auto [q, pg] = v.back();
+            v.pop_back();
+            por_proceso[q].compartidas.erase(pg);
+            quitar_de_proceso(por_proceso[pid], i);
+            marcos[i].pid = q;
+            marcos[i].pagina = pg;
+            agregar_a_proceso(por_proceso[q], i);
+        } else {
+            v.erase(std::find(v.begin(), v.end(), std::make_pair(pid, pagina)));
+            por_proceso[pid].compartidas.erase(pagina);
+        }
+        if (v.empty()) mapeos_extra.erase(it);
+    }
+
+    // Todas las paginas de un proceso salen de memoria; las compartidas quedan para los demas
+    // (las de un segmento se escriben a disco aunque el proceso termine: el segmento sigue)
+    void soltar_paginas(int pid, bool write_back) {
+        MemoriaProceso &mp = por_proceso[pid];
+        while (mp.primer_marco >= 0) {
+            int i = mp.primer_marco;
+            quitar_mapeo(pid, marcos[i].pagina, i, write_back || marco_segmento.count(i));
+        }
+        while (!mp.compartidas.empty()) {
+            auto [pg, i] = *mp.compartidas.begin();
+            quitar_mapeo(pid, pg, i, write_back || marco_segmento.count(i));
+        }
+    }
+
+    // Segmento mapeado en 'pagina' del proceso (y la pagina dentro de el), o -1
+    static int segmento_en(const MemoriaProceso &mp, int pagina, int &pagina_segmento) {
+        for (const MapeoSegmento &m : mp.segmentos)
+            if (pagina >= m.base && pagina - m.base < m.paginas) {
+                pagina_segmento = pagina - m.base;
+                return m.segmento;
+            }
+        return -1;
+    }
+
+    // Saca la pagina del marco i y lo deja libre; con write_back una pagina sucia va a disco
+    void expulsar(int i, bool write_back) {
+        soltar_compartidos(i);
+        int pid = marcos[i].pid;
+        tabla_paginas.borrar(pid, marcos[i].pagina);
+        if (tlb.activo()) tlb.invalidar(pid, marcos[i].pagina);
+        desenlazar(i);
+        quitar_de_proceso(por_proceso[pid], i);
+        if (write_back && bit(bits_sucio, i)) escrituras_disco++;
+        quitar_bit(bits_referencia, i);
+        quitar_bit(bits_sucio, i);
+        contador_edad[i] = 0;
+        marcos[i] = Frame(); // marco libre
+        devolver_marco_libre(i);
+        marcos_ocupados--;
+    }
+
+    // ----- Working Set por proceso con control PFF -----
+    void actualizar_ventana(MemoriaProceso &mp, int pagina) {
+        mp.ventana.push_back(pagina);
+        if (mp.conteo[pagina]++ == 0 && !mp.suspendido) suma_ws++;
+        recortar_ventana(mp);
+    }
+
+    void recortar_ventana(MemoriaProceso &mp) {
+        while ((int)mp.ventana.size() > ventana_ws) {
+            auto it = mp.conteo.find(mp.ventana.front());
+            mp.ventana.pop_front();
+            if (--it->second == 0) {
+                mp.conteo.erase(it);
+                if (!mp.suspendido) suma_ws--;
+            }
+        }
+    }
+
+    void suspender(int pid) {
+        MemoriaProceso &mp = por_proceso[pid];
+        mp.suspendido = true;
+        mp.suspensiones++;
+        suspensiones++;
+        suma_ws -= (long long)mp.conteo.size();
+        soltar_paginas(pid, true); // swap-out
+        mp.cuota = 0;
+        cola_suspendidos.push_back(pid);
+        cambios_suspension.push_back(pid);
+        emitir(traza, NivelTraza::EVENTOS, TipoEvento::MEM_SUSPENSION, tick_traza(), tick_traza(), pid,
+               (int)mp.conteo.size(), (int)(suma_ws + (long long)mp.conteo.size()), max_marcos);
+    }
+
+    void reanudar(int pid) {
+        MemoriaProceso &mp = por_proceso[pid];
+        mp.suspendido = false;
+        reanudaciones++;
+        suma_ws += (long long)mp.conteo.size();
+        cola_suspendidos.erase(std::find(cola_suspendidos.begin(), cola_suspendidos.end(), pid));
+        cambios_suspension.push_back(pid);
+        emitir(traza, NivelTraza::EVENTOS, TipoEvento::MEM_REANUDACION, tick_traza(), tick_traza(), pid,
+               (int)mp.conteo.size(), (int)suma_ws, max_marcos);
+    }
+
+    // Thrashing: mientras la suma de working sets no entre en memoria se suspende el proceso
+    // con el working set mas grande (nunca 'protegido', el que esta fallando). Con lugar de
+    // sobra vuelve el suspendido mas antiguo.
+    void control_de_carga(int protegido) {
+        while (suma_ws > max_marcos) {
+            int victima = -1;
+            size_t mayor = 0;
+            por_proceso.para_cada([&](int q, const MemoriaProceso &m) {
+                if (q != protegido && !m.suspendido && m.conteo.size() > mayor) { victima = q; mayor = m.conteo.size(); }
+            });
+            if (victima < 0) break;
+            suspender(victima);
+        }
+        while (!cola_suspendidos.empty()) {
+            int q = cola_suspendidos.front();
+            if (suma_ws + (long long)por_proceso[q].conteo.size() > max_marcos) break;
+            reanudar(q);
+        }
+    }
+
+    // Marco para un fallo de 'pid' en WS. PFF: si fallo hace menos de 'ventana' accesos propios
+    // su cuota crece un marco; si no, la cuota baja a su working set y se liberan sus paginas
+    // fuera de el. Dentro de la cuota reemplaza una pagina propia (primero fuera del working
+    // set, si no la menos reciente); debajo usa un marco libre o le quita uno a quien exceda
+    // su cuota.
+    int marco_ws(int pid, MemoriaProceso &mp) {
+        long long intervalo = mp.accesos - mp.acceso_ultimo_fallo;
+        mp.acceso_ultimo_fallo = mp.accesos;
+        if (intervalo <= ventana_ws) {
+            mp.cuota = std::min(max_marcos, mp.cuota + 1);
+        } else {
+            mp.cuota = std::max(1, (int)mp.conteo.size());
+            for (int i = mp.primer_marco; i >= 0;) {
+                int sig = marcos[i].siguiente_proceso;
+                if (!mp.conteo.count(marcos[i].pagina)) quitar_mapeo(pid, marcos[i].pagina, i, true);
+                i = sig;
+            }
+        }
+        control_de_carga(pid);
+
+        if (mp.residentes >= mp.cuota && mp.residentes > 0) {
+            int elegido = -1;
+            for (int i = mp.primer_marco; i >= 0; i = marcos[i].siguiente_proceso) {
+                if (!mp.conteo.count(marcos[i].pagina)) return i;
+                if (elegido < 0 || marcos[i].last_used < marcos[elegido].last_used) elegido = i;
+            }
+            return elegido;
+        }
+        int libre = tomar_marco_libre();
+        if (libre >= 0) return libre;
+        for (int i = lru_cabeza; i >= 0; i = marcos[i].siguiente) {
+            const MemoriaProceso &o = por_proceso[marcos[i].pid];
+            if (o.residentes > o.cuota) return i;
+        }
+        return lru_cabeza;
+    }
+
+    // ----- Reconfiguracion en linea -----
+    // Cambia solo los metadatos de la politica: las paginas residentes, la lista de recencia
+    // y los bits R/D se conservan.
+    void cambiar_politica(PoliticaMemoria pol, int ventana) {
+        PoliticaMemoria antes = politica;
+        politica = pol;
+        ventana_ws = std::max(1, ventana);
+        if (antes == PoliticaMemoria::WS && pol != PoliticaMemoria::WS) {
+            // sin control de carga: vuelven todos los suspendidos
+            while (!cola_suspendidos.empty()) reanudar(cola_suspendidos.front());
+            por_proceso.para_cada([](int, MemoriaProceso &mp) {
+                mp.ventana.clear();
+                mp.conteo.clear();
+                mp.cuota = 0;
+            });
+            suma_ws = 0;
+        } else if (pol == PoliticaMemoria::WS && antes != PoliticaMemoria::WS) {
+            // ventanas vacias; la cuota arranca en lo que ya tiene residente
+            por_proceso.para_cada([](int, MemoriaProceso &mp) {
+                mp.cuota = mp.residentes;
+                mp.acceso_ultimo_fallo = mp.accesos;
+            });
+        } else if (pol == PoliticaMemoria::WS) {
+            por_proceso.para_cada([this](int, MemoriaProceso &mp) { recortar_ventana(mp); });
+        }
+        if (pol == PoliticaMemoria::FIFO && antes != PoliticaMemoria::FIFO) {
+            // sin orden de carga: se aproxima con el de recencia, los libres al final
+            cola_fifo.clear();
+            for (int i = lru_cabeza; i >= 0; i = marcos[i].siguiente) cola_fifo.push_back(i);
+            for (int i = 0; i < max_marcos; ++i)
+                if (marcos[i].pid == -1) cola_fifo.push_back(i);
+        }
+        if (pol == PoliticaMemoria::AGING && antes != PoliticaMemoria::AGING)
+            std::fill(contador_edad.begin(), contador_edad.end(), 0);
+    }
+
+    // Mueve la pagina del marco i al marco libre j (ya tomado del mapa de libres).
+    // La tabla de paginas la reconstruye redimensionar.
+    void mover_marco(int i, int j) {
+        const Frame f = marcos[i];
+        marcos[j] = f;
+        if (f.anterior >= 0) marcos[f.anterior].siguiente = j;
+        else lru_cabeza = j;
+        if (f.siguiente >= 0) marcos[f.siguiente].anterior = j;
+        else lru_cola = j;
+        if (f.anterior_proceso >= 0) marcos[f.anterior_proceso].siguiente_proceso = j;
+        else por_proceso[f.pid].primer_marco = j;
+        if (f.siguiente_proceso >= 0) marcos[f.siguiente_proceso].anterior_proceso = j;
+        if (bit(bits_referencia, i)) poner_bit(bits_referencia, j);
+        if (bit(bits_sucio, i)) poner_bit(bits_sucio, j);
+        if (bit(bits_cow, i)) poner_bit(bits_cow, j);
+        contador_edad[j] = contador_edad[i];
+        quitar_bit(bits_referencia, i);
+        quitar_bit(bits_sucio, i);
+        quitar_bit(bits_cow, i);
+        contador_edad[i] = 0;
+        if (tlb.activo()) tlb.invalidar(f.pid, f.pagina);
+        auto extra = mapeos_extra.find(i);
+        if (extra != mapeos_extra.end()) {
+            std::vector<std::pair<int, int>> v = std::move(extra->second);
+            mapeos_extra.erase(extra);
+            for (auto [q, pg] : v) {
+                por_proceso[q].compartidas[pg] = j;
+                if (tlb.activo()) tlb.invalidar(q, pg);
+            }
+            mapeos_extra[j] = std::move(v);
+        }
+        auto seg = marco_segmento.find(i);
+        if (seg != marco_segmento.end()) {
+            std::pair<int, int> sp = seg->second;
+            marco_segmento.erase(seg);
+            marco_segmento[j] = sp;
+            segmentos[sp.first].marcos[sp.second] = j;
+        }
+        marcos[i] = Frame();
+    }
+
+    // Lleva la memoria a n marcos. Requiere marcos_ocupados <= n: las paginas de los marcos
+    // que desaparecen se mudan a huecos libres de los primeros n.
+    void redimensionar(int n) {
+        if (n < max_marcos) {
+            std::vector<int> destino(max_marcos, -1);
+            std::vector<char> es_destino(n, 0);
+            for (int i = n; i < max_marcos; ++i) {
+                if (marcos[i].pid == -1) continue;
+                int j = tomar_marco_libre(); // el libre de menor indice: siempre < n
+                mover_marco(i, j);
+                destino[i] = j;
+                es_destino[j] = 1;
+            }
+            // cada hueco ocupado hereda el lugar en la cola FIFO de la pagina que recibio
+            std::deque<int> cola;
+            for (int i : cola_fifo) {
+                int k = i >= n ? destino[i] : es_destino[i] ? -1 : i;
+                if (k >= 0) cola.push_back(k);
+            }
+            cola_fifo.swap(cola);
+            marcos.resize(n);
+        } else {
+            marcos.resize(n);
+            for (int i = max_marcos; i < n; ++i) cola_fifo.push_back(i);
+        }
+        max_marcos = n;
+        size_t palabras = (n + 63) / 64;
+        libres.assign(palabras, 0);
+        for (int i = 0; i < n; ++i)
+            if (marcos[i].pid == -1) libres[i / 64] |= 1ULL << (i % 64);
+        palabra_libre = 0;
+        bits_referencia.resize(palabras, 0);
+        bits_sucio.resize(palabras, 0);
+        bits_cow.resize(palabras, 0);
+        contador_edad.resize(palabras * 64, 0);
+        if (manecilla >= n) manecilla = 0;
+        tabla_paginas = TablaPaginasPlana(n);
+        for (int i = 0; i < n; ++i)
+            if (marcos[i].pid != -1) tabla_paginas.insertar(marcos[i].pid, marcos[i].pagina, i);
+        for (auto &[i, v] : mapeos_extra)
+            for (auto [q, pg] : v) tabla_paginas.insertar(q, pg, i);
+    }
+
+    // Trae (pid, pagina) a un marco: libre, de la cuota WS o victima de la politica. Suma a
+    // 'tiempo' el write-back de una victima sucia. Devuelve el marco.
+    int cargar_pagina(int pid, int pagina, MemoriaProceso &mp, bool escritura, int &tiempo) {
+        // WORKING SET: cuota por proceso (PFF); el resto toma primero un marco libre
+        int elegido = politica == PoliticaMemoria::WS ? marco_ws(pid, mp) : tomar_marco_libre();
+
+        if (elegido == -1) elegido = elegir_victima();
+
+        // limpiar entrada anterior
+        int pid_victima = marcos[elegido].pid;
+        int pag_victima = marcos[elegido].pagina;
+        if (pid_victima != -1) {
+            soltar_compartidos(elegido);
+            tabla_paginas.borrar(pid_victima, pag_victima);
+            if (tlb.activo()) tlb.invalidar(pid_victima, pag_victima);
+            desenlazar(elegido);
+            MemoriaProceso &mv = por_proceso[pid_victima];
+            quitar_de_proceso(mv, elegido);
+            mv.reemplazadas++;
+            if (bit(bits_sucio, elegido)) {
+                escrituras_disco++;
+                tiempo += COSTO_FALLO; // write-back antes de traer la pagina nueva
+            }
+        } else {
+            marcos_ocupados++;
+        }
+
+        // asignar
+        marcos[elegido].pid = pid;
+        marcos[elegido].pagina = pagina;
+        marcos[elegido].last_used = reloj_tick;
+        enlazar_al_final(elegido);
+        agregar_a_proceso(mp, elegido);
+        poner_bit(bits_referencia, elegido);
+        if (escritura) poner_bit(bits_sucio, elegido);
+        else quitar_bit(bits_sucio, elegido);
+        contador_edad[elegido] = 0;
+        tabla_paginas.insertar(pid, pagina, elegido);
+        if (tlb.activo()) tlb.insertar(pid, pagina, elegido);
+        return elegido;
+    }
+
+    // Escritura sobre una pagina copy-on-write. Si otro proceso todavia comparte el marco la
+    // pagina se copia a un marco propio; si ya era el ultimo mapeo solo se quita la proteccion.
+    // No cuenta como fallo de pagina.
+    int fallo_cow(int pid, int pagina, MemoriaProceso &mp, int marco, bool &hit) {
+        hit = true;
+        fallos_cow++;
+        mp.fallos_cow++;
+        int costo;
+        if (mapeos_extra.count(marco)) {
+            copias_cow++;
+            costo = COSTO_COW;
+            quitar_mapeo(pid, pagina, marco, false);
+            marco = cargar_pagina(pid, pagina, mp, true, costo);
+        } else {
+            costo = COSTO_RECORRIDO;
+            quitar_bit(bits_cow, marco);
+            marcos[marco].last_used = reloj_tick;
+            if (marco != lru_cola) { desenlazar(marco); enlazar_al_final(marco); }
+            poner_bit(bits_referencia, marco);
+            poner_bit(bits_sucio, marco);
+        }
+        if (registro_accesos) registro_accesos->registrar(reloj_tick, pid, pagina, true, true, costo);
+        emitir(traza, NivelTraza::EVENTOS, TipoEvento::MEM_COW, tick_traza(), tick_traza(), pid, pagina, marco, costo);
+        return costo;
+    }
+
+public:
+    // Costo en ticks de cada camino de un acceso. Sin TLB todo acierto cuesta COSTO_ACIERTO.
+    static constexpr int COSTO_ACIERTO = 1;   // traduccion encontrada en el TLB
+    static constexpr int COSTO_RECORRIDO = 3; // fallo de TLB: recorrer la tabla de paginas
+    static constexpr int COSTO_FALLO = 10;    // fallo de pagina; otro tanto si la victima esta sucia
+    static constexpr int COSTO_COW = 5;       // copia de un marco en memoria, sin ir a disco
+
+    GestorMarcos(int n_marcos = 3, PoliticaMemoria pol = PoliticaMemoria::FIFO, int ventana = 5,
+                 RegistroEventos *t = nullptr, TrazaAccesos *ta = nullptr)
+        : max_marcos(n_marcos), marcos_ocupados(0), palabra_libre(0), lru_cabeza(-1), lru_cola(-1),
+          reloj_tick(0), accesos_totales(0), fallos_totales(0), escrituras_disco(0), registro_accesos(ta), politica(pol),
+          ventana_ws(ventana), traza(t), manecilla(0), tabla_paginas(n_marcos), recorridos(0), ticks_fallos(0),
+          suma_ws(0), suspensiones(0), reanudaciones(0), reconfiguraciones(0), accesos_reconfig(0),
+          fallos_reconfig(0), tick_reconfig(0), forks(0), fallos_cow(0), copias_cow(0), fallos_menores(0) {
+        marcos.resize(max_marcos);
+        for (int i = 0; i < max_marcos; ++i) cola_fifo.push_back(i);
+        libres.assign((max_marcos + 63) / 64, ~0ULL);
+        if (max_marcos % 64) libres.back() = (1ULL << (max_marcos % 64)) - 1;
+        bits_referencia.assign(libres.size(), 0);
+        bits_sucio.assign(libres.size(), 0);
+        bits_cow.assign(libres.size(), 0);
+        contador_edad.assign(libres.size() * 64, 0);
+    }
+
+    // 'escritura' marca la pagina como sucia: expulsarla cuesta una escritura a disco.
+    // Un pid fuera de [0, MAX_PID_TRAZA) no accede: devuelve 0 ticks sin tocar contadores.
+    int acceder_pagina(int pid, int pagina, bool &hit, bool escritura = false) {
+        hit = false;
+        if ((uint32_t)pid >= MAX_PID_TRAZA) return 0;
+        reloj_tick++;
+        accesos_totales++;
+        MemoriaProceso &mp = memoria_de(pid);
+        mp.accesos++;
+        if (politica == PoliticaMemoria::AGING && reloj_tick % std::max(1, ventana_ws) == 0) envejecer();
+        if (politica == PoliticaMemoria::WS) {
+            // sin planificador (memload, sweep) un suspendido que accede vuelve a memoria
+            if (mp.suspendido) reanudar(pid);
+            actualizar_ventana(mp, pagina);
+        }
+
+        // HIT: el TLB o una sola busqueda en la tabla plana; el marco pasa al final de la lista de recencia
+        int costo = COSTO_ACIERTO;
+        int marco = tlb.activo() ? tlb.buscar(pid, pagina) : -1;
+        if (marco < 0) {
+            marco = tabla_paginas.buscar(pid, pagina);
+            if (marco >= 0 && tlb.activo()) {
+                tlb.insertar(pid, pagina, marco);
+                recorridos++;
+                costo = COSTO_RECORRIDO;
+            }
+        }
+        // pagina de un segmento compartido que otro proceso ya trajo: fallo menor, sin disco
+        int segmento = -1, pagina_segmento = 0;
+        if (marco < 0 && !mp.segmentos.empty() && (segmento = segmento_en(mp, pagina, pagina_segmento)) >= 0) {
+            auto &residentes = segmentos[segmento].marcos;
+            auto it = residentes.find(pagina_segmento);
+            if (it != residentes.end()) {
+                marco = it->second;
+                mapear_extra(marco, pid, pagina);
+                if (tlb.activo()) tlb.insertar(pid, pagina, marco);
+                fallos_menores++;
+                costo = COSTO_RECORRIDO;
+                emitir(traza, NivelTraza::EVENTOS, TipoEvento::MEM_COMPARTIDA, tick_traza(), tick_traza(), pid, pagina,
+                       segmento, marco);
+            }
+        }
+        if (marco >= 0) {
+            if (escritura && bit(bits_cow, marco)) return fallo_cow(pid, pagina, mp, marco, hit);
+            hit = true;
+            marcos[marco].last_used = reloj_tick;
+            if (marco != lru_cola) { desenlazar(marco); enlazar_al_final(marco); }
+            poner_bit(bits_referencia, marco);
+            if (escritura) poner_bit(bits_sucio, marco);
+            if (registro_accesos) registro_accesos->registrar(reloj_tick, pid, pagina, true, escritura, costo);
+            emitir(traza, NivelTraza::EVENTOS, TipoEvento::MEM_ACCESO, tick_traza(), tick_traza(), pid, pagina, 1, costo);
+            return costo;
+        }
+
+        // MISS
+        hit = false;
+        fallos_totales++;
+        mp.fallos++;
+        int tiempo_miss = COSTO_FALLO;
+
+        int elegido = cargar_pagina(pid, pagina, mp, escritura, tiempo_miss);
+        if (segmento >= 0) {
+            segmentos[segmento].marcos[pagina_segmento] = elegido;
+            marco_segmento[elegido] = {segmento, pagina_segmento};
+        }
+        ticks_fallos += tiempo_miss;
+
+        if (registro_accesos) registro_accesos->registrar(reloj_tick, pid, pagina, false, escritura, tiempo_miss);
+        emitir(traza, NivelTraza::EVENTOS, TipoEvento::MEM_ACCESO, tick_traza(), tick_traza(), pid, pagina, 0, tiempo_miss);
+        return tiempo_miss;
+    }
+
+    // Reproduccion masiva (memload): sin eventos por acceso. 'escritura' puede ser nullptr.
+    // Devuelve los ticks simulados del lote.
+    long long acceder_lote(const uint32_t *pid, const uint32_t *pagina, const uint8_t *escritura, size_t n) {
+        RegistroEventos *t = traza;
+        traza = nullptr;
+        long long ticks = 0;
+        bool hit;
+        for (size_t i = 0; i < n; ++i)
+            ticks += acceder_pagina((int)pid[i], (int)pagina[i], hit, escritura && escritura[i]);
+        traza = t;
+        return ticks;
+    }
+
+    // Reconfiguracion en linea (memmode): conserva las paginas residentes, las tablas, los
+    // contadores y las trazas. Al achicar expulsa victimas de la politica nueva hasta que las
+    // paginas entren en n_marcos; al crecer agrega marcos libres. Deja una marca en la traza
+    // de eventos y devuelve cuantas paginas expulso.
+    int reconfigurar(int n_marcos, PoliticaMemoria pol, int ventana) {
+        n_marcos = std::max(1, n_marcos);
+        int marcos_antes = max_marcos;
+        PoliticaMemoria politica_antes = politica;
+        cambiar_politica(pol, ventana);
+        int expulsadas = 0;
+        while (marcos_ocupados > n_marcos) {
+            int v = elegir_victima();
+            por_proceso[marcos[v].pid].reemplazadas++;
+            expulsar(v, true);
+            expulsadas++;
+        }
+        redimensionar(n_marcos);
+        if (politica == PoliticaMemoria::WS) {
+            por_proceso.para_cada([this](int, MemoriaProceso &mp) { mp.cuota = std::min(mp.cuota, max_marcos); });
+            control_de_carga(-1);
+        }
+        reconfiguraciones++;
+        accesos_reconfig = accesos_totales;
+        fallos_reconfig = fallos_totales;
+        tick_reconfig = reloj_tick;
+        if (traza) {
+            std::string detalle = std::string("politica ") + nombre_politica(politica_antes) + " -> " + nombre_politica(politica) +
+                             ", marcos " + std::to_string(marcos_antes) + " -> " + std::to_string(max_marcos);
+            emitir(traza, NivelTraza::EVENTOS, TipoEvento::MEM_RECONFIGURACION, tick_traza(), tick_traza(), -1,
+                   traza->texto(detalle), expulsadas);
+        }
+        return expulsadas;
+    }
+    int get_max_marcos() const { return max_marcos; }
+    int get_ventana() const { return ventana_ws; }
+
+    PoliticaMemoria get_politica() const { return politica; }
+
+    // Reemplaza el TLB (vacio); entradas = 0 lo quita
+    void set_tlb(const ConfigTLB &c) { tlb = TLB(c); }
+    const TLB &get_tlb() const { return tlb; }
+    long long get_recorridos() const { return recorridos; }
+    long long get_ticks_fallos() const { return ticks_fallos; }
+
+    // Llamado por los planificadores cuando otro proceso toma una CPU
+    void cambio_contexto() { tlb.cambio_contexto(); }
+    long long get_accesos() const { return accesos_totales; }
+    long long get_fallos() const { return fallos_totales; }
+
+    // Secuencia de accesos registrada (pid << 32 | pagina) para analizarla fuera de linea (memcurva)
+    std::vector<uint64_t> referencias_registradas() const {
+        return registro_accesos ? registro_accesos->referencias() : std::vector<uint64_t>();
+    }
+    long long get_escrituras_disco() const { return escrituras_disco; }
+
+    // Resto de metodos igual...
+    void mostrar_estado() const {
+        std::cout << "\n[Memoria] Estado de marcos (index: PID->Pagina, last_used)\n";
+        for (int i = 0; i < max_marcos; ++i) {
+            std::cout << " Marco[" << std::setw(2) << i << "]: ";
+            if (marcos[i].pid == -1) std::cout << "(libre)\n";
+            else {
+                std::cout << "PID " << marcos[i].pid << " -> Pag " << marcos[i].pagina
+                     << " (last=" << marcos[i].last_used;
+                if (politica == PoliticaMemoria::CLOCK || politica == PoliticaMemoria::SEGUNDA_OPORTUNIDAD)
+                    std::cout << ", R=" << bit(bits_referencia, i) << " D=" << bit(bits_sucio, i)
+                         << (i == manecilla ? ", <- manecilla" : "");
+                else if (politica == PoliticaMemoria::AGING)
+                    std::cout << ", R=" << bit(bits_referencia, i) << " edad=" << (int)contador_edad[i];
+                auto extra = mapeos_extra.find(i);
+                if (extra != mapeos_extra.end()) std::cout << ", refs=" << 1 + extra->second.size();
+                if (bit(bits_cow, i)) std::cout << ", COW";
+                auto seg = marco_segmento.find(i);
+                if (seg != marco_segmento.end()) std::cout << ", segmento " << seg->second.first;
+                std::cout << ")\n";
+            }
+        }
+        std::cout << "Accesos totales: " << accesos_totales
+             << " | Fallos totales: " << fallos_totales
+             << " | Tasa fallos: "
+             << (accesos_totales>0 ? (double)fallos_totales/accesos_totales : 0.0)
+             << "\n";
+        std::cout << "Politica: " << nombre_politica(politica) << " | Escrituras a disco (paginas sucias): "
+             << escrituras_disco << "\n";
+        if (politica == PoliticaMemoria::WS) {
+            std::cout << "Suma de working sets: " << suma_ws << " / " << max_marcos << " marcos | Suspensiones: "
+                 << suspensiones << " | Reanudaciones: " << reanudaciones << " | Suspendidos:";
+            if (cola_suspendidos.empty()) std::cout << " ninguno";
+            for (int pid : cola_suspendidos) std::cout << " " << pid;
+            std::cout << "\n";
+        }
+        if (forks > 0 || !segmentos.empty()) {
+            long long ahorrados = 0;
+            for (auto &[i, v] : mapeos_extra) ahorrados += (long long)v.size();
+            std::cout << "Marcos compartidos: " << mapeos_extra.size() << " | Marcos ahorrados: " << ahorrados
+                 << " | Forks: " << forks << " | Segmentos: " << segmentos.size() << "\n"
+                 << "Fallos COW: " << fallos_cow << " (copias " << copias_cow << ") | Fallos menores (segmentos): "
+                 << fallos_menores << " (no cuentan como fallos de pagina)\n";
+        }
+        if (reconfiguraciones > 0) {
+            long long a = accesos_totales - accesos_reconfig, f = fallos_totales - fallos_reconfig;
+            std::cout << "Desde la reconfiguracion #" << reconfiguraciones << " (tick " << tick_reconfig
+                 << "): accesos " << a << " | fallos " << f << " | tasa fallos " << (a > 0 ? (double)f / a : 0.0)
+                 << "\n";
+        }
+        if (tlb.activo()) {
+            mostrar_tlb();
+            long long aciertos_tlb = tlb.aciertos;
+            std::cout << "Costo (ticks): TLB " << aciertos_tlb * COSTO_ACIERTO << " | Recorridos de tabla "
+                 << recorridos * COSTO_RECORRIDO << " | Fallos de pagina " << ticks_fallos << "\n";
+        }
+    }
+
+    void mostrar_tlb() const {
+        const ConfigTLB &c = tlb.config();
+        std::cout << "TLB: " << c.entradas << " entradas, " << c.asociatividad << " vias, "
+             << (c.reemplazo == ReemplazoTLB::LRU ? "LRU" : "aleatorio") << ", " << (c.asid ? "ASID" : "vaciado")
+             << " | Aciertos: " << tlb.aciertos << " | Fallos: " << tlb.fallos
+             << " | Tasa aciertos: " << tlb.tasa_aciertos() << " | Vaciados: " << tlb.vaciados << "\n";
+    }
+
+    void mostrar_trazas(int ultimos = 20) const {
+        std::cout << "\n[Memoria] Ultimas trazas de acceso (tick pid pag HIT tiempo):\n";
+        if (!registro_accesos) return;
+        int n = (int)std::min<size_t>(std::max(0, ultimos), registro_accesos->en_anillo());
+        for (int i = n - 1; i >= 0; --i) {
+            const auto &r = registro_accesos->reciente(i);
+            std::cout << " " << r.tick << " | PID " << r.pid << " | Pag " << r.pagina
+                 << " | " << (r.hit ? "HIT " : "MISS")
+                 << " | t=" << r.tiempo_acceso_simulado << "\n";
+        }
+    }
+
+    // Libera todos los marcos usados por un proceso terminado: recorre solo su lista, O(paginas propias).
+    // Los contadores de accesos y fallos se conservan para memstats.
+    void liberar_proceso(int pid) {
+        if (!por_proceso.buscar(pid)) return;
+        MemoriaProceso &mp = por_proceso[pid];
+        soltar_paginas(pid, false);
+        for (const MapeoSegmento &m : mp.segmentos) segmentos[m.segmento].procesos--;
+        mp.segmentos.clear();
+        // su working set deja de contar; puede haber lugar para un suspendido
+        if (mp.suspendido) cola_suspendidos.erase(std::find(cola_suspendidos.begin(), cola_suspendidos.end(), pid));
+        else suma_ws -= (long long)mp.conteo.size();
+        mp.suspendido = false;
+        mp.ventana.clear();
+        mp.conteo.clear();
+        mp.cuota = 0;
+        if (politica == PoliticaMemoria::WS) control_de_carga(-1);
+    }
+
+    // fork: el hijo mapea las paginas residentes del padre en los mismos marcos. Las privadas
+    // quedan de solo lectura en ambos (copy-on-write); las de segmentos siguen compartidas y
+    // el hijo hereda los segmentos. Devuelve cuantas paginas comparten.
+    int fork(int padre, int hijo) {
+        MemoriaProceso &mp = por_proceso[padre];
+        std::vector<std::pair<int, int>> paginas; // (pagina, marco)
+        for (int i = mp.primer_marco; i >= 0; i = marcos[i].siguiente_proceso) paginas.push_back({marcos[i].pagina, i});
+        for (auto [pg, i] : mp.compartidas) paginas.push_back({pg, i});
+        for (auto [pg, i] : paginas) {
+            mapear_extra(i, hijo, pg);
+            if (!marco_segmento.count(i)) poner_bit(bits_cow, i);
+        }
+        por_proceso[hijo].segmentos = mp.segmentos;
+        for (const MapeoSegmento &m : mp.segmentos) segmentos[m.segmento].procesos++;
+        forks++;
+        return (int)paginas.size();
+    }
+
+    // Mapea el segmento compartido 'segmento' (se crea con 'paginas' paginas la primera vez;
+    // despues conserva su tamaño) en las paginas base.. del proceso. Las paginas privadas que
+    // hubiera en ese rango se descartan. Devuelve las paginas mapeadas, o -1 si el rango se
+    // superpone con otro segmento del proceso.
+    int mapear_segmento(int pid, int segmento, int base, int paginas) {
+        MemoriaProceso &mp = memoria_de(pid);
+        SegmentoCompartido &sc = segmentos[segmento];
+        if (sc.paginas == 0) sc.paginas = std::max(1, paginas);
+        int n = sc.paginas;
+        for (const MapeoSegmento &m : mp.segmentos)
+            if (base < m.base + m.paginas && m.base < base + n) return -1;
+        for (int pg = base; pg < base + n; ++pg) {
+            int i = tabla_paginas.buscar(pid, pg);
+            if (i >= 0) quitar_mapeo(pid, pg, i, true);
+        }
+        mp.segmentos.push_back({segmento, base, n});
+        sc.procesos++;
+        return n;
+    }
+
+    // Control de carga (WS): el planificador retira a los suspendidos de la cola de listos
+    bool suspendido(int pid) const {
+        const MemoriaProceso *mp = por_proceso.buscar(pid);
+        return mp && mp->suspendido;
+    }
+    bool hay_cambios_suspension() const { return !cambios_suspension.empty(); }
+    std::vector<int> tomar_cambios_suspension() {
+        std::vector<int> c;
+        c.swap(cambios_suspension);
+        return c;
+    }
+
+    // Contadores de un proceso (nullptr si nunca accedio a memoria)
+    const MemoriaProceso *memoria_proceso(int pid) const {
+        return por_proceso.buscar(pid);
+    }
+
+    void mostrar_estadisticas_proceso(int pid) const {
+        const MemoriaProceso *mp = memoria_proceso(pid);
+        if (!mp || mp->accesos == 0) {
+            std::cout << "[Memoria] PID " << pid << " sin accesos registrados\n";
+            return;
+        }
+        std::cout << "\n[Memoria] PID " << pid << "\n"
+             << "Accesos: " << mp->accesos << " | Fallos: " << mp->fallos
+             << " | Tasa fallos: " << (double)mp->fallos / mp->accesos << "\n"
+             << "Paginas residentes: " << mp->residentes << " | Paginas reemplazadas: " << mp->reemplazadas << "\n";
+        if (politica == PoliticaMemoria::WS)
+            std::cout << "Working set: " << mp->conteo.size() << " paginas (ultimos " << ventana_ws << " accesos) | Cuota PFF: "
+                 << mp->cuota << " marcos | " << (mp->suspendido ? "SUSPENDIDO" : "activo")
+                 << " | Suspensiones: " << mp->suspensiones << "\n";
+        if (!mp->compartidas.empty() || mp->fallos_cow > 0 || !mp->segmentos.empty()) {
+            std::cout << "Paginas en marcos de otro proceso: " << mp->compartidas.size() << " | Fallos COW: " << mp->fallos_cow;
+            for (const MapeoSegmento &m : mp->segmentos)
+                std::cout << " | Segmento " << m.segmento << " en paginas " << m.base << ".." << m.base + m.paginas - 1;
+            std::cout << "\n";
+        }
+        if (mp->residentes == 0) return;
+        const int MAX_LISTADO = 32;
+        std::cout << "Marcos:";
+        int n = 0;
+        for (int i = mp->primer_marco; i >= 0 && n < MAX_LISTADO; i = marcos[i].siguiente_proceso, ++n)
+            std::cout << " " << i << "(P" << marcos[i].pagina << ")";
+        if (mp->residentes > MAX_LISTADO) std::cout << " ...";
+        std::cout << "\n";
+    }
+
+    void visualizar_memoria_ascii() const {
+        std::cout << "\n[Visualizacion ASCII - Marcos de Memoria]\n";
+        if (marcos.empty()) {
+            std::cout << "(Sin marcos)\n";
+            return;
+        }
+
+        const std::string verde = "\033[1;32m"; // verde para hit
+        const std::string rojo = "\033[1;31m";  // rojo para miss
+        const std::string gris = "\033[1;90m";  // gris para libre
+        const std::string reset = "\033[0m";
+
+        // determinar los ultimos accesos para marcar colores
+        std::map<int, bool> ultimo_hit_por_marco;
+        if (registro_accesos && registro_accesos->en_anillo() > 0) {
+            auto r = registro_accesos->reciente(0);
+            // busca el marco donde cayo el acceso
+            for (int i = 0; i < max_marcos; ++i) {
+                if (marcos[i].pid == r.pid && marcos[i].pagina == r.pagina) {
+                    ultimo_hit_por_marco[i] = r.hit;
+                }
+            }
+        }
+
+        std::cout << "+--------------------------------------------------+\n";
+        for (int i = 0; i < max_marcos; ++i) {
+            std::string color = gris;
+            std::string contenido = "(libre)";
+            if (marcos[i].pid != -1) {
+                contenido = "PID " + std::to_string(marcos[i].pid) +
+                            " P" + std::to_string(marcos[i].pagina);
+                if (ultimo_hit_por_marco.count(i))
+                    color = (ultimo_hit_por_marco.at(i) ? verde : rojo);
+            }
+            std::cout << "| Marco[" << std::setw(2) << i << "]: "
+                 << color << std::setw(15) << std::left << contenido << reset
+                 << " (last=" << std::setw(3) << marcos[i].last_used << ") |\n";
+        }
+        std::cout << "+--------------------------------------------------+\n";
+        std::cout << "HIT = verde | MISS = rojo | Libre = gris\n";
+        if (tlb.activo()) mostrar_tlb();
+    }
+
+};
+
+
+// ------------------------- Metricas por nucleo -------------------------
+struct MetricasNucleo {
+    long long ticks_ocupados = 0;
+    long long despachos = 0;
+    long long migraciones = 0;        // procesos tomados de la cola de otra CPU
+    int terminados = 0;               // procesos que terminaron en esta CPU
+    long long espera_terminados = 0;
+    long long retorno_terminados = 0;
+};
+
+
+// Metricas agregadas de una simulacion (stats y barrido de parametros)
+struct ResumenPlanificador {
+    int finalizados = 0;
+    double espera_promedio = 0;
+    double retorno_promedio = 0;
+    int makespan = 0;
+    double utilizacion = 0;
+    long long despachos = 0;
+    long long migraciones = 0;
+};
+
+
+ResumenPlanificador calcular_resumen(const TablaProcesos &tabla, const std::vector<MetricasNucleo> &nucleos,
+                                     int tiempo_actual, long long capacidad);
+
+
+// Resumen comun a ambos planificadores: agregado y, con varias CPUs, detalle por nucleo.
+// capacidad = suma de ticks disponibles de todas las CPUs activas en cada tramo.
+// Las CPUs retiradas con 'cpus' siguen en la tabla si llegaron a despachar algo.
+void imprimir_estadisticas(const TablaProcesos &tabla, const std::vector<MetricasNucleo> &nucleos, int activos,
+                           int tiempo_actual, long long capacidad);
+
+
+// El reloj de los planificadores es int: t + d satura en INT_MAX en vez de desbordar.
+// Con el avance por eventos un 'run' enorme es barato, asi que el tope se alcanza de verdad.
+inline int sumar_reloj(int t, long long d) { return (int)std::min<long long>((long long)t + d, INT_MAX); }
+
+
+// ------------------------- Planificador Round Robin -------------------------
+// Multiprocesador: cada CPU tiene su propia cola FIFO. Los procesos nuevos van a la CPU
+// menos cargada y una CPU que queda ociosa toma el primer proceso de la cola mas larga.
+class PlanificadorRR {
+private:
+    struct Nucleo {
+        std::queue<int> cola_listos; // PIDs
+        int proceso_en_cpu = 0; // PID actualmente en CPU (0 = ninguno)
+        int ultimo_en_cpu = 0;  // ultimo PID despachado; 0 tras terminar
+        MetricasNucleo m;
+    };
+
+    TablaProcesos tabla;
+    std::vector<Nucleo> nucleos;
+    int activos; // CPUs en uso (las retiradas conservan sus metricas)
+    long long capacidad_ticks;
+    // procesos con llegada futura: min-heap de (tiempo_llegada, pid)
+    std::priority_queue<std::pair<int,int>, std::vector<std::pair<int,int>>, std::greater<std::pair<int,int>>> llegadas_pendientes;
+    int tiempo_quantum;
+    int tiempo_actual;
+    int finalizados; // terminados normalmente o con kill
+    RegistroEventos *traza;
+
+    // con una sola CPU los eventos conservan el formato monoprocesador
+    int id_evento(int k) const { return activos > 1 ? k : -1; }
+
+    int carga(int k) const {
+        return (int)nucleos[k].cola_listos.size() + (nucleos[k].proceso_en_cpu ? 1 : 0);
+    }
+
+    int nucleo_menos_cargado() const {
+        int mejor = 0;
+        for (int k = 1; k < activos; ++k)
+            if (carga(k) < carga(mejor)) mejor = k;
+        return mejor;
+    }
+
+    // Pone el proceso en LISTO y lo encola una sola vez (en_cola evita duplicados).
+    // Sin CPU explicita vuelve a la suya, o a la menos cargada si aun no tiene.
+    void encolar_listo(int pid, int instante, int k = -1) {
+        tabla.estado[pid] = EstadoProceso::LISTO;
+        if (tabla.en_cola[pid]) return;
+        if (k < 0) k = (tabla.nucleo[pid] >= 0 && tabla.nucleo[pid] < activos) ? tabla.nucleo[pid] : nucleo_menos_cargado();
+        tabla.en_cola[pid] = 1;
+        tabla.tiempo_listo[pid] = instante;
+        tabla.nucleo[pid] = (int16_t)k;
+        nucleos[k].cola_listos.push(pid);
+    }
+
+    // Espera acumulada incluyendo el tramo actual en la cola de listos
+    int espera_actual(int pid) const {
+        int espera = tabla.tiempo_espera_acumulado[pid];
+        if (tabla.en_cola[pid] && tabla.estado[pid] == EstadoProceso::LISTO)
+            espera += tiempo_actual - tabla.tiempo_listo[pid];
+        return espera;
+    }
+
+    // descartar del frente los que dejaron de estar LISTO mientras esperaban (su espera ya se
+    // cerro en TablaProcesos::bloquear o al suspenderse)
+    void descartar_no_listos(Nucleo &n) {
+        while (!n.cola_listos.empty() && tabla.estado[n.cola_listos.front()] != EstadoProceso::LISTO) {
+            tabla.en_cola[n.cola_listos.front()] = 0;
+            n.cola_listos.pop();
+        }
+    }
+
+    int sacar_frente(Nucleo &n) {
+        int pid = n.cola_listos.front();
+        n.cola_listos.pop();
+        tabla.en_cola[pid] = 0;
+        return pid;
+    }
+
+    // Pone el proceso en la CPU k y actualiza sus metricas
+    void poner_en_cpu(int k, int pid) {
+        Nucleo &n = nucleos[k];
+        n.proceso_en_cpu = pid;
+        n.m.despachos++;
+        tabla.nucleo[pid] = (int16_t)k;
+        tabla.tiempo_espera_acumulado[pid] += tiempo_actual - tabla.tiempo_listo[pid];
+        if (tabla.tiempo_inicio[pid] == -1) tabla.tiempo_inicio[pid] = tiempo_actual;
+        tabla.estado[pid] = EstadoProceso::EJECUTANDO;
+        tabla.quantum_consumido[pid] = 0;
+        if (tabla.response_time[pid] == -1) {
+            tabla.response_time[pid] = tiempo_actual - tabla.tiempo_llegada[pid];
+        }
+        tabla.quantums_served[pid]++;
+        emitir(traza, NivelTraza::EVENTOS, TipoEvento::DESPACHO_RR, tiempo_actual, tiempo_actual, pid,
+               0, 0, 0, id_evento(k));
+    }
+
+    // Saca el siguiente proceso de la cola propia y lo pone en CPU. false si no hay ninguno.
+    bool despachar(int k) {
+        descartar_no_listos(nucleos[k]);
+        if (nucleos[k].cola_listos.empty()) return false;
+        poner_en_cpu(k, sacar_frente(nucleos[k]));
+        return true;
+    }
+
+    // CPU ociosa: toma el proceso mas antiguo de la cola mas larga de otra CPU
+    bool robar(int k) {
+        int victima = -1;
+        for (int j = 0; j < activos; ++j) {
+            if (j == k) continue;
+            descartar_no_listos(nucleos[j]);
+            if (!nucleos[j].cola_listos.empty() &&
+                (victima < 0 || nucleos[j].cola_listos.size() > nucleos[victima].cola_listos.size()))
+                victima = j;
+        }
+        if (victima < 0) return false;
+        int pid = sacar_frente(nucleos[victima]);
+        nucleos[k].m.migraciones++;
+        emitir(traza, NivelTraza::EVENTOS, TipoEvento::MIGRACION, tiempo_actual, tiempo_actual, pid,
+               victima, 0, 0, k);
+        poner_en_cpu(k, pid);
+        return true;
+    }
+
+    // Control de carga del gestor (WS): un suspendido deja la CPU y la cola de listos
+    // (descartar_no_listos lo saca al llegar al frente); al reanudarse vuelve a encolarse.
+    // Con el gestor en otra politica no hay cambios y esto no cuesta nada.
+    void aplicar_suspensiones(GestorMarcos &gestor) {
+        for (int pid : gestor.tomar_cambios_suspension()) {
+            if (!tabla.existe(pid)) continue;
+            EstadoProceso &e = tabla.estado[pid];
+            bool suspendido = gestor.suspendido(pid);
+            if (suspendido && (e == EstadoProceso::LISTO || e == EstadoProceso::EJECUTANDO)) {
+                if (e == EstadoProceso::LISTO && tabla.en_cola[pid])
+                    tabla.tiempo_espera_acumulado[pid] += tiempo_actual - tabla.tiempo_listo[pid];
+                e = EstadoProceso::SUSPENDIDO;
+            } else if (!suspendido && e == EstadoProceso::SUSPENDIDO) {
+                encolar_listo(pid, tiempo_actual);
+                tabla.tiempo_listo[pid] = tiempo_actual; // la suspension no cuenta como espera
+            }
+        }
+    }
+
+public:
+    PlanificadorRR(int quantum=2, RegistroEventos *t = nullptr)
+        : nucleos(1), activos(1), capacidad_ticks(0), tiempo_quantum(quantum), tiempo_actual(0), finalizados(0),
+          traza(t) {
+        tabla.reloj = &tiempo_actual;
+    }
+    // la tabla apunta al reloj propio: no se copia ni se mueve
+    PlanificadorRR(const PlanificadorRR &) = delete;
+    PlanificadorRR &operator=(const PlanificadorRR &) = delete;
+
+    int crear_proceso(int tiempo_requerido, int llegada_offset = 0) {
+        int llegada = sumar_reloj(tiempo_actual, llegada_offset);
+        int pid = tabla.crear(tiempo_requerido, llegada);
+        // Si llegada == tiempo_actual lo ponemos en cola de listos, si no, espera en el heap de llegadas
+        if (llegada <= tiempo_actual) encolar_listo(pid, tiempo_actual);
+        else llegadas_pendientes.push({llegada, pid});
+        return pid;
+    }
+
+    // Alta masiva desde una carga binaria: llegadas relativas al tiempo actual.
+    // Las llegadas futuras reconstruyen el heap de una vez si estaba vacio. Devuelve el primer PID.
+    int crear_procesos(size_t n, const uint32_t *tiempos, const uint32_t *llegadas) {
+        tabla.reservar(tabla.cantidad() + n);
+        int primero = tabla.crear_lote(n, tiempos, llegadas, tiempo_actual);
+        std::vector<std::pair<int,int>> futuras;
+        futuras.reserve(n);
+        sugerir_paginas_grandes(futuras);
+        for (size_t i = 0; i < n; ++i) {
+            int pid = primero + (int)i;
+            if (tabla.tiempo_llegada[pid] <= tiempo_actual) encolar_listo(pid, tiempo_actual);
+            else futuras.push_back({tabla.tiempo_llegada[pid], pid});
+        }
+        if (llegadas_pendientes.empty())
+            llegadas_pendientes = decltype(llegadas_pendientes)(std::greater<std::pair<int,int>>(), std::move(futuras));
+        else
+            for (auto &f : futuras) llegadas_pendientes.push(f);
+        return primero;
+    }
+
+    // Exponer enqueue para semaforo signal. Si el proceso se bloqueo mientras esperaba turno
+    // sigue en la cola: su espera vuelve a contar desde ahora, el tramo BLOQUEADO no es espera.
+    void enqueue_ready(int pid) {
+        if (!tabla.existe(pid) || tabla.estado[pid] == EstadoProceso::TERMINADO) return;
+        for (int k = 0; k < activos; ++k)
+            if (nucleos[k].proceso_en_cpu == pid) {
+                tabla.estado[pid] = EstadoProceso::EJECUTANDO; // desperto sin soltar la CPU
+                return;
+            }
+        if (tabla.en_cola[pid]) tabla.tiempo_listo[pid] = tiempo_actual;
+        encolar_listo(pid, tiempo_actual);
+    }
+
+    // Mueve a la cola de listos los procesos con llegada <= limite.
+    // Solo toca el tope del heap: O(k log n) para k llegadas.
+    void incorporar_llegadas(int limite) {
+        while (!llegadas_pendientes.empty() && llegadas_pendientes.top().first <= limite) {
+            auto [llegada, pid] = llegadas_pendientes.top();
+            llegadas_pendientes.pop();
+            // terminado (kill) o bloqueado antes de llegar: no entra a la cola
+            if (tabla.estado[pid] != EstadoProceso::LISTO) continue;
+            encolar_listo(pid, llegada);
+        }
+    }
+
+    // Cambia la cantidad de CPUs simuladas. Al reducir, los procesos de las CPUs retiradas
+    // (en ejecucion o en cola) se reparten entre las que quedan conservando su espera.
+    void set_nucleos(int n) {
+        n = std::max(1, n);
+        if ((int)nucleos.size() < n) nucleos.resize(n);
+        int antes = activos;
+        activos = n;
+        for (int k = n; k < antes; ++k) {
+            Nucleo &viejo = nucleos[k];
+            if (viejo.proceso_en_cpu) {
+                int pid = viejo.proceso_en_cpu;
+                viejo.proceso_en_cpu = 0;
+                if (tabla.estado[pid] == EstadoProceso::EJECUTANDO) {
+                    tabla.nucleo[pid] = -1;
+                    encolar_listo(pid, tiempo_actual);
+                }
+            }
+            while (!viejo.cola_listos.empty()) {
+                int pid = sacar_frente(viejo);
+                if (tabla.estado[pid] != EstadoProceso::LISTO) continue;
+                tabla.nucleo[pid] = -1;
+                encolar_listo(pid, tabla.tiempo_listo[pid]);
+            }
+        }
+    }
+
+    int get_nucleos() const { return activos; }
+
+    // PID que corrio en la CPU k durante el ultimo paso (0 si no hubo o ya termino)
+    int ultimo_en_cpu(int k) const { return k < activos ? nucleos[k].ultimo_en_cpu : 0; }
+
+    int get_tiempo() const { return tiempo_actual; }
+    bool completo() const { return finalizados == tabla.cantidad(); }
+
+    // Corre hasta que todos los procesos terminen (barrido de parametros). 'limite' corta
+    // cargas que nunca terminarian, p.ej. con procesos bloqueados.
+    void ejecutar_hasta_terminar(GestorMarcos &gestor, int limite = INT_MAX / 2) {
+        while (!completo() && tiempo_actual < limite) avanzar_hasta_evento(limite, gestor);
+    }
+
+    ResumenPlanificador resumen() const {
+        std::vector<MetricasNucleo> m;
+        for (auto &n : nucleos) m.push_back(n.m);
+        return calcular_resumen(tabla, m, tiempo_actual, capacidad_ticks);
+    }
+
+    // Ejecutar un tick (1 unidad de tiempo). Gestiona seleccion, preempcion y metricas.
+    void tick(GestorMarcos &gestor) {
+        if (tiempo_actual < INT_MAX) avanzar_hasta_evento(tiempo_actual + 1, gestor);
+    }
+
+    // Ejecutar N ticks saltando de evento en evento (fin de quantum, terminacion, llegada).
+    // Produce exactamente las mismas metricas que N llamadas a tick(). Devuelve los ticks
+    // ejecutados: menos que N si el reloj llega a INT_MAX.
+    int ejecutar_ticks(int n, GestorMarcos &gestor) {
+        int inicio = tiempo_actual, fin = sumar_reloj(tiempo_actual, std::max(0, n)), pasos = 0;
+        while (tiempo_actual < fin) { avanzar_hasta_evento(fin, gestor); pasos++; }
+        emitir(traza, NivelTraza::RESUMEN, TipoEvento::RUN_RESUMEN, inicio, fin, 0, pasos);
+        return fin - inicio;
+    }
+
+    // Avanza tiempo_actual hasta el siguiente instante interesante sin pasar de 'fin'.
+    // Todas las CPUs avanzan juntas hasta el evento mas cercano de cualquiera de ellas.
+    void avanzar_hasta_evento(int fin, GestorMarcos &gestor) {
+        if (gestor.hay_cambios_suspension()) aplicar_suspensiones(gestor);
+        // incorporar llegadas antes de seleccionar
+        incorporar_llegadas(tiempo_actual);
+
+        // cada CPU despacha primero de su propia cola
+        for (int k = 0; k < activos; ++k) {
+            Nucleo &n = nucleos[k];
+            // el proceso en CPU pudo ser terminado (kill) o bloqueado (E/S) desde la consola
+            if (n.proceso_en_cpu && tabla.estado[n.proceso_en_cpu] != EstadoProceso::EJECUTANDO) n.proceso_en_cpu = 0;
+            if (!n.proceso_en_cpu) despachar(k);
+        }
+        // luego las que siguen ociosas roban trabajo de las demas
+        if (activos > 1) {
+            // si una CPU no encuentra nada que robar, las demas tampoco
+            for (int k = 0; k < activos; ++k)
+                if (!nucleos[k].proceso_en_cpu && !robar(k)) break;
+        }
+        // cambio de contexto: sin ASID el TLB se vacia
+        for (int k = 0; k < activos; ++k) {
+            Nucleo &n = nucleos[k];
+            if (n.proceso_en_cpu && n.proceso_en_cpu != n.ultimo_en_cpu) gestor.cambio_contexto();
+            if (n.proceso_en_cpu) n.ultimo_en_cpu = n.proceso_en_cpu;
+        }
+
+        // siguiente evento: llegada, terminacion o fin de quantum de alguna CPU.
+        // Una CPU sin competencia en su cola solo re-despacha al mismo proceso al vencer
+        // el quantum, asi que sus fines de quantum no cortan el tramo.
+        int inicio = tiempo_actual;
+        int hasta = fin;
+        if (!llegadas_pendientes.empty()) hasta = std::min(hasta, llegadas_pendientes.top().first);
+        for (int k = 0; k < activos; ++k) {
+            Nucleo &n = nucleos[k];
+            int p = n.proceso_en_cpu;
+            if (!p) continue;
+            hasta = std::min(hasta, sumar_reloj(inicio, std::max(1, tabla.tiempo_restante[p])));
+            descartar_no_listos(n);
+            if (!n.cola_listos.empty())
+                hasta = std::min(hasta, sumar_reloj(inicio, std::max(1, tiempo_quantum - tabla.quantum_consumido[p])));
+        }
+
+        tiempo_actual = hasta;
+        capacidad_ticks += (long long)(hasta - inicio) * activos;
+
+        for (int k = 0; k < activos; ++k) {
+            Nucleo &n = nucleos[k];
+            int p = n.proceso_en_cpu;
+            if (!p) {
+                emitir(traza, NivelTraza::TICKS, TipoEvento::CPU_IDLE, inicio, hasta - 1, 0, 0, 0, 0, id_evento(k));
+                continue;
+            }
+            int redespachos = 0;
+            if (n.cola_listos.empty()) {
+                int primer_fin_q = sumar_reloj(inicio, std::max(1, tiempo_quantum - tabla.quantum_consumido[p]));
+                if (primer_fin_q < hasta) {
+                    redespachos = (hasta - 1 - primer_fin_q) / tiempo_quantum + 1;
+                    int ultimo_fin_q = primer_fin_q + (redespachos - 1) * tiempo_quantum;
+                    tabla.quantum_consumido[p] = hasta - ultimo_fin_q;
+                    tabla.quantums_served[p] += redespachos;
+                    n.m.despachos += redespachos;
+                } else {
+                    tabla.quantum_consumido[p] += hasta - inicio;
+                }
+            } else {
+                tabla.quantum_consumido[p] += hasta - inicio;
+            }
+            tabla.tiempo_restante[p] -= hasta - inicio;
+            n.m.ticks_ocupados += hasta - inicio;
+
+            emitir(traza, NivelTraza::TICKS, TipoEvento::EJECUCION_RR, inicio + 1, tiempo_actual, p,
+                   tabla.tiempo_restante[p], tabla.quantum_consumido[p], redespachos, id_evento(k));
+        }
+
+        for (int k = 0; k < activos; ++k) {
+            Nucleo &n = nucleos[k];
+            int p = n.proceso_en_cpu;
+            if (!p) continue;
+
+            // comprobacion: si proceso termina
+            if (tabla.tiempo_restante[p] <= 0) {
+                tabla.estado[p] = EstadoProceso::TERMINADO;
+                tabla.tiempo_finalizacion[p] = tiempo_actual;
+                int retorno = tiempo_actual - tabla.tiempo_llegada[p];
+                n.m.terminados++;
+                n.m.retorno_terminados += retorno;
+                n.m.espera_terminados += retorno - tabla.tiempo_requerido[p];
+                finalizados++;
+                emitir(traza, NivelTraza::RESUMEN, TipoEvento::TERMINACION, tiempo_actual, tiempo_actual, p,
+                       0, 0, 0, id_evento(k));
+                // liberar marcos asociados
+                gestor.liberar_proceso(p);
+                n.ultimo_en_cpu = 0;
+                n.proceso_en_cpu = 0;
+            }
+            // si quantum consumido alcanza el quantum => preemption
+            else if (tabla.quantum_consumido[p] >= tiempo_quantum) {
+                encolar_listo(p, tiempo_actual, k);
+                emitir(traza, NivelTraza::EVENTOS, TipoEvento::PREEMPCION_RR, tiempo_actual, tiempo_actual, p,
+                       0, 0, 0, id_evento(k));
+                n.proceso_en_cpu = 0;
+            }
+        }
+    }
+
+    void listar_procesos() {
+        std::cout << "\nID\tEstado\tRest\tInicio\tFin\tEspera\tResp\tQuantServed";
+        if (activos > 1) std::cout << "\tCPU";
+        std::cout << "\n";
+        for (int pid = 1; pid <= tabla.cantidad(); ++pid) {
+            std::cout << pid << "\t" << nombre_estado(tabla.estado[pid]) << "\t" << tabla.tiempo_restante[pid] << "\t"
+                 << tabla.tiempo_inicio[pid] << "\t" << tabla.tiempo_finalizacion[pid] << "\t"
+                 << espera_actual(pid) << "\t" << tabla.response_time[pid] << "\t" << tabla.quantums_served[pid];
+            if (activos > 1) std::cout << "\t" << tabla.nucleo[pid];
+            std::cout << "\n";
+        }
+    }
+
+    void estadisticas_generales() {
+        std::vector<MetricasNucleo> m;
+        for (auto &n : nucleos) m.push_back(n.m);
+        imprimir_estadisticas(tabla, m, activos, tiempo_actual, capacidad_ticks);
+    }
+
+    HandleProceso obtener_proceso(int id) {
+        if (!tabla.existe(id)) return {};
+        return {&tabla, id};
+    }
+    bool es_propio(HandleProceso p) const { return p.tabla == &tabla; }
+
+    void terminar_proceso(int id) {
+        if (!tabla.existe(id)) {
+            std::cout << "[!] No existe proceso " << id << "\n";
+            return;
+        }
+        if (tabla.estado[id] != EstadoProceso::TERMINADO) finalizados++;
+        tabla.estado[id] = EstadoProceso::TERMINADO;
+        tabla.tiempo_finalizacion[id] = tiempo_actual;
+        std::cout << "[X] Proceso " << id << " terminado manualmente.\n";
+    }
+};
+
+
+// ------------------------- Heap indexado para SJF -------------------------
+// Min-heap de PIDs por (tiempo_restante, pid). La tabla guarda la posicion de cada proceso
+// en indice_heap, asi remover (kill) y reubicar tras un cambio de clave cuestan O(log n).
+class HeapSJF {
+private:
+    TablaProcesos *tabla;
+    std::vector<int> datos;
+
+    void intercambiar(size_t i, size_t j) {
+        std::swap(datos[i], datos[j]);
+        tabla->indice_heap[datos[i]] = (int)i;
+        tabla->indice_heap[datos[j]] = (int)j;
+    }
+
+    void subir(size_t i) {
+        while (i > 0) {
+            size_t padre = (i - 1) / 2;
+            if (!menor(datos[i], datos[padre])) break;
+            intercambiar(i, padre);
+            i = padre;
+        }
+    }
+
+    void bajar(size_t i) {
+        size_t n = datos.size();
+        while (true) {
+            size_t izq = 2 * i + 1, der = izq + 1, m = i;
+            if (izq < n && menor(datos[izq], datos[m])) m = izq;
+            if (der < n && menor(datos[der], datos[m])) m = der;
+            if (m == i) break;
+            intercambiar(i, m);
+            i = m;
+        }
+    }
+
+public:
+    explicit HeapSJF(TablaProcesos *t) : tabla(t) {}
+
+    bool menor(int a, int b) const {
+        int ra = tabla->tiempo_restante[a], rb = tabla->tiempo_restante[b];
+        if (ra != rb) return ra < rb;
+        return a < b;
+    }
+
+    bool vacio() const { return datos.empty(); }
+    size_t size() const { return datos.size(); }
+    int tope() const { return datos.front(); }
+    bool contiene(int pid) const { return tabla->indice_heap[pid] >= 0; }
+    void reservar(size_t n) { datos.reserve(n); }
+
+    void push(int pid) {
+        tabla->indice_heap[pid] = (int)datos.size();
+        datos.push_back(pid);
+        subir(datos.size() - 1);
+    }
+
+    // Inserta muchos PIDs de una vez y reconstruye el heap de abajo hacia arriba: O(n)
+    void push_lote(const std::vector<int> &pids) {
+        if (pids.size() < datos.size()) { for (int pid : pids) push(pid); return; }
+        for (int pid : pids) {
+            tabla->indice_heap[pid] = (int)datos.size();
+            datos.push_back(pid);
+        }
+        for (size_t i = datos.size() / 2; i-- > 0;) bajar(i);
+    }
+
+    int pop() {
+        int pid = datos.front();
+        remover(pid);
+        return pid;
+    }
+
+    // Reubica el proceso tras cambiar su tiempo_restante (decrease-key / increase-key)
+    void actualizar(int pid) {
+        subir(tabla->indice_heap[pid]);
+        bajar(tabla->indice_heap[pid]);
+    }
+
+    void remover(int pid) {
+        size_t i = tabla->indice_heap[pid];
+        size_t ultimo = datos.size() - 1;
+        if (i != ultimo) intercambiar(i, ultimo);
+        datos.pop_back();
+        tabla->indice_heap[pid] = -1;
+        if (i < datos.size()) actualizar(datos[i]);
+    }
+};
+
+
+// ------------------------- Planificador SJF -------------------------
+// SJF preemptivo (SRTF): cuando llega un proceso con menor tiempo restante desaloja al de la CPU.
+// Multiprocesador: un heap por CPU; los procesos nuevos van a la CPU menos cargada y una CPU
+// ociosa toma el trabajo mas corto del heap mas grande.
+class PlanificadorSJF {
+private:
+    struct Nucleo {
+        HeapSJF cola_listos;
+        int proceso_en_cpu = 0; // 0 = ninguno
+        int ultimo_en_cpu = 0;  // ultimo PID despachado; 0 tras terminar
+        MetricasNucleo m;
+        explicit Nucleo(TablaProcesos *t) : cola_listos(t) {}
+    };
+
+    TablaProcesos tabla;
+    std::vector<Nucleo> nucleos;
+    int activos;
+    long long capacidad_ticks;
+    std::priority_queue<std::pair<int,int>, std::vector<std::pair<int,int>>, std::greater<std::pair<int,int>>> llegadas_pendientes;
+    int tiempo_actual;
+    int finalizados;
+    RegistroEventos *traza;
+
+    int id_evento(int k) const { return activos > 1 ? k : -1; }
+
+    int carga(int k) const {
+        return (int)nucleos[k].cola_listos.size() + (nucleos[k].proceso_en_cpu ? 1 : 0);
+    }
+
+    int nucleo_menos_cargado() const {
+        int mejor = 0;
+        for (int k = 1; k < activos; ++k)
+            if (carga(k) < carga(mejor)) mejor = k;
+        return mejor;
+    }
+
+    int espera_actual(int pid) const {
+        int espera = tabla.tiempo_espera_acumulado[pid];
+        if (tabla.estado[pid] == EstadoProceso::LISTO && tabla.indice_heap[pid] >= 0)
+            espera += tiempo_actual - tabla.tiempo_listo[pid];
+        return espera;
+    }
+
+    void encolar_listo(int pid, int instante, int k) {
+        tabla.estado[pid] = EstadoProceso::LISTO;
+        tabla.tiempo_listo[pid] = instante;
+        tabla.nucleo[pid] = (int16_t)k;
+        nucleos[k].cola_listos.push(pid);
+    }
+
+    void incorporar_llegadas(int limite) {
+        while (!llegadas_pendientes.empty() && llegadas_pendientes.top().first <= limite) {
+            auto [llegada, pid] = llegadas_pendientes.top();
+            llegadas_pendientes.pop();
+            if (tabla.estado[pid] != EstadoProceso::LISTO) continue; // terminado antes de llegar
+            encolar_listo(pid, llegada, nucleo_menos_cargado());
+        }
+    }
+
+    int proxima_llegada(int fin) const {
+        return llegadas_pendientes.empty() ? fin : std::min(fin, llegadas_pendientes.top().first);
+    }
+
+    // Descarta del tope del heap a los que dejaron de estar LISTO (bloqueados en la impresora,
+    // un semaforo o E/S; su espera ya se cerro al bloquearse) y saca el trabajo mas corto que
+    // queda. 0 si no hay ninguno.
+    void descartar_no_listos(Nucleo &n) {
+        while (!n.cola_listos.vacio() && tabla.estado[n.cola_listos.tope()] != EstadoProceso::LISTO)
+            n.cola_listos.pop();
+    }
+
+    int sacar_listo(Nucleo &n) {
+        descartar_no_listos(n);
+        return n.cola_listos.vacio() ? 0 : n.cola_listos.pop();
+    }
+
+    void poner_en_cpu(int k, int pid) {
+        Nucleo &n = nucleos[k];
+        n.proceso_en_cpu = pid;
+        n.m.despachos++;
+        tabla.nucleo[pid] = (int16_t)k;
+        tabla.tiempo_espera_acumulado[pid] += tiempo_actual - tabla.tiempo_listo[pid];
+        if (tabla.tiempo_inicio[pid] == -1)
+            tabla.tiempo_inicio[pid] = tiempo_actual;
+
+        tabla.estado[pid] = EstadoProceso::EJECUTANDO;
+        emitir(traza, NivelTraza::EVENTOS, TipoEvento::SELECCION_SJF, tiempo_actual, tiempo_actual, pid,
+               0, 0, 0, id_evento(k));
+    }
+
+    // CPU ociosa: toma el trabajo mas corto del heap mas grande de otra CPU
+    bool robar(int k) {
+        int victima = -1;
+        for (int j = 0; j < activos; ++j) {
+            if (j == k) continue;
+            descartar_no_listos(nucleos[j]);
+            if (nucleos[j].cola_listos.vacio()) continue;
+            if (victima < 0 || nucleos[j].cola_listos.size() > nucleos[victima].cola_listos.size())
+                victima = j;
+        }
+        if (victima < 0) return false;
+        int pid = sacar_listo(nucleos[victima]);
+        if (!pid) return false;
+        nucleos[k].m.migraciones++;
+        emitir(traza, NivelTraza::EVENTOS, TipoEvento::MIGRACION, tiempo_actual, tiempo_actual, pid,
+               victima, 0, 0, k);
+        poner_en_cpu(k, pid);
+        return true;
+    }
+
+public:
+    PlanificadorSJF(RegistroEventos *t = nullptr)
+        : activos(1), capacidad_ticks(0), tiempo_actual(0), finalizados(0), traza(t) {
+        nucleos.emplace_back(&tabla);
+        tabla.reloj = &tiempo_actual;
+    }
+    // los heaps apuntan a la tabla propia y la tabla al reloj: no se copia ni se mueve
+    PlanificadorSJF(const PlanificadorSJF &) = delete;
+    PlanificadorSJF &operator=(const PlanificadorSJF &) = delete;
+
+    int crear_proceso(int tiempo_requerido, int llegada_offset = 0) {
+        int llegada = sumar_reloj(tiempo_actual, llegada_offset);
+        int pid = tabla.crear(tiempo_requerido, llegada);
+        if (llegada <= tiempo_actual) encolar_listo(pid, tiempo_actual, nucleo_menos_cargado());
+        else llegadas_pendientes.push({llegada, pid});
+        return pid;
+    }
+
+    // Alta masiva desde una carga binaria: los listos entran a cada heap con push_lote (O(n)).
+    int crear_procesos(size_t n, const uint32_t *tiempos, const uint32_t *llegadas) {
+        tabla.reservar(tabla.cantidad() + n);
+        int primero = tabla.crear_lote(n, tiempos, llegadas, tiempo_actual);
+        std::vector<std::vector<int>> listos(activos);
+        std::vector<size_t> carga_lote(activos);
+        for (int k = 0; k < activos; ++k) carga_lote[k] = carga(k);
+        std::vector<std::pair<int,int>> futuras;
+        futuras.reserve(n);
+        sugerir_paginas_grandes(futuras);
+        for (size_t i = 0; i < n; ++i) {
+            int pid = primero + (int)i;
+            if (tabla.tiempo_llegada[pid] > tiempo_actual) {
+                futuras.push_back({tabla.tiempo_llegada[pid], pid});
+                continue;
+            }
+            int k = (int)(std::min_element(carga_lote.begin(), carga_lote.end()) - carga_lote.begin());
+            carga_lote[k]++;
+            tabla.nucleo[pid] = (int16_t)k;
+            listos[k].push_back(pid);
+        }
+        for (int k = 0; k < activos; ++k) nucleos[k].cola_listos.push_lote(listos[k]);
+        if (llegadas_pendientes.empty())
+            llegadas_pendientes = decltype(llegadas_pendientes)(std::greater<std::pair<int,int>>(), std::move(futuras));
+        else
+            for (auto &f : futuras) llegadas_pendientes.push(f);
+        return primero;
+    }
+
+    // Cambia la cantidad de CPUs. Los procesos de las CPUs retiradas vuelven a repartirse.
+    void set_nucleos(int n) {
+        n = std::max(1, n);
+        while ((int)nucleos.size() < n) nucleos.emplace_back(&tabla);
+        int antes = activos;
+        activos = n;
+        for (int k = n; k < antes; ++k) {
+            Nucleo &viejo = nucleos[k];
+            if (viejo.proceso_en_cpu) {
+                int pid = viejo.proceso_en_cpu;
+                viejo.proceso_en_cpu = 0;
+                if (tabla.estado[pid] == EstadoProceso::EJECUTANDO)
+                    encolar_listo(pid, tiempo_actual, nucleo_menos_cargado());
+            }
+            while (!viejo.cola_listos.vacio()) {
+                int pid = viejo.cola_listos.pop();
+                if (tabla.estado[pid] == EstadoProceso::LISTO)
+                    encolar_listo(pid, tabla.tiempo_listo[pid], nucleo_menos_cargado());
+            }
+        }
+    }
+
+    int get_nucleos() const { return activos; }
+
+    // Reencola un proceso que se desbloquea (semaforo, E/S, impresora), como en RR
+    void enqueue_ready(int pid) {
+        if (!tabla.existe(pid) || tabla.estado[pid] == EstadoProceso::TERMINADO) return;
+        for (int k = 0; k < activos; ++k)
+            if (nucleos[k].proceso_en_cpu == pid) {
+                tabla.estado[pid] = EstadoProceso::EJECUTANDO;
+                return;
+            }
+        if (tabla.indice_heap[pid] >= 0) {
+            tabla.estado[pid] = EstadoProceso::LISTO;
+            tabla.tiempo_listo[pid] = tiempo_actual;
+            return;
+        }
+        encolar_listo(pid, tiempo_actual, nucleo_menos_cargado());
+    }
+
+    int get_tiempo() const { return tiempo_actual; }
+    bool completo() const { return finalizados == tabla.cantidad(); }
+
+    // Corre hasta que todos los procesos terminen (barrido de parametros). 'limite' corta
+    // cargas que nunca terminarian, p.ej. con procesos bloqueados.
+    void ejecutar_hasta_terminar(GestorMarcos &gestor, int limite = INT_MAX / 2) {
+        while (!completo() && tiempo_actual < limite) avanzar_hasta_evento(limite, gestor);
+    }
+
+    ResumenPlanificador resumen() const {
+        std::vector<MetricasNucleo> m;
+        for (auto &n : nucleos) m.push_back(n.m);
+        return calcular_resumen(tabla, m, tiempo_actual, capacidad_ticks);
+    }
+
+    void tick(GestorMarcos &gestor) {
+        if (tiempo_actual < INT_MAX) avanzar_hasta_evento(tiempo_actual + 1, gestor);
+    }
+
+    // Ejecutar N ticks saltando de evento en evento (llegada, preempcion, terminacion).
+    // Produce exactamente las mismas metricas que N llamadas a tick(). Devuelve los ticks
+    // ejecutados, como en RR.
+    int ejecutar_ticks(int n, GestorMarcos &gestor) {
+        int inicio = tiempo_actual, fin = sumar_reloj(tiempo_actual, std::max(0, n)), pasos = 0;
+        while (tiempo_actual < fin) { avanzar_hasta_evento(fin, gestor); pasos++; }
+        emitir(traza, NivelTraza::RESUMEN, TipoEvento::RUN_RESUMEN, inicio, fin, 0, pasos);
+        return fin - inicio;
+    }
+
+    // Avanza tiempo_actual hasta el siguiente instante interesante sin pasar de 'fin'.
+    void avanzar_hasta_evento(int fin, GestorMarcos &gestor) {
+        incorporar_llegadas(tiempo_actual);
+
+        for (int k = 0; k < activos; ++k) {
+            Nucleo &n = nucleos[k];
+            // el proceso en CPU pudo quedar bloqueado (impresora) desde la consola
+            if (n.proceso_en_cpu && tabla.estado[n.proceso_en_cpu] != EstadoProceso::EJECUTANDO) n.proceso_en_cpu = 0;
+
+            // SRTF: solo una llegada puede traer un trabajo mas corto que el que esta en CPU
+            descartar_no_listos(n);
+            if (n.proceso_en_cpu && !n.cola_listos.vacio()
+                && tabla.tiempo_restante[n.cola_listos.tope()] < tabla.tiempo_restante[n.proceso_en_cpu]) {
+                emitir(traza, NivelTraza::EVENTOS, TipoEvento::PREEMPCION_SRTF, tiempo_actual, tiempo_actual,
+                       n.proceso_en_cpu, tabla.tiempo_restante[n.proceso_en_cpu], n.cola_listos.tope(), 0, id_evento(k));
+                encolar_listo(n.proceso_en_cpu, tiempo_actual, k);
+                n.proceso_en_cpu = 0;
+            }
+
+            // seleccionar el proceso con menor tiempo restante: O(log n)
+            if (!n.proceso_en_cpu) {
+                int pid = sacar_listo(n);
+                if (pid) poner_en_cpu(k, pid);
+            }
+        }
+        if (activos > 1) {
+            // si una CPU no encuentra nada que robar, las demas tampoco
+            for (int k = 0; k < activos; ++k)
+                if (!nucleos[k].proceso_en_cpu && !robar(k)) break;
+        }
+        // cambio de contexto: sin ASID el TLB se vacia
+        for (int k = 0; k < activos; ++k) {
+            Nucleo &n = nucleos[k];
+            if (n.proceso_en_cpu && n.proceso_en_cpu != n.ultimo_en_cpu) gestor.cambio_contexto();
+            if (n.proceso_en_cpu) n.ultimo_en_cpu = n.proceso_en_cpu;
+        }
+
+        // cada CPU corre hasta terminar, hasta la proxima llegada (posible preempcion)
+        // o hasta el final del tramo
+        int inicio = tiempo_actual;
+        int hasta = proxima_llegada(fin);
+        for (int k = 0; k < activos; ++k)
+            if (nucleos[k].proceso_en_cpu)
+                hasta = std::min(hasta, sumar_reloj(inicio, std::max(1, tabla.tiempo_restante[nucleos[k].proceso_en_cpu])));
+        tiempo_actual = hasta;
+        capacidad_ticks += (long long)(hasta - inicio) * activos;
+
+        for (int k = 0; k < activos; ++k) {
+            Nucleo &n = nucleos[k];
+            int p = n.proceso_en_cpu;
+            if (!p) {
+                emitir(traza, NivelTraza::TICKS, TipoEvento::CPU_IDLE, inicio, hasta - 1, 0, 0, 0, 0, id_evento(k));
+                continue;
+            }
+            tabla.tiempo_restante[p] -= hasta - inicio;
+            n.m.ticks_ocupados += hasta - inicio;
+
+            emitir(traza, NivelTraza::TICKS, TipoEvento::EJECUCION_SJF, inicio + 1, tiempo_actual, p,
+                   tabla.tiempo_restante[p], 0, 0, id_evento(k));
+
+            if (tabla.tiempo_restante[p] <= 0) {
+                tabla.estado[p] = EstadoProceso::TERMINADO;
+                tabla.tiempo_finalizacion[p] = tiempo_actual;
+                int retorno = tiempo_actual - tabla.tiempo_llegada[p];
+                n.m.terminados++;
+                n.m.retorno_terminados += retorno;
+                n.m.espera_terminados += retorno - tabla.tiempo_requerido[p];
+                finalizados++;
+                emitir(traza, NivelTraza::RESUMEN, TipoEvento::TERMINACION, tiempo_actual, tiempo_actual, p,
+                       0, 0, 0, id_evento(k));
+                gestor.liberar_proceso(p);
+                n.ultimo_en_cpu = 0;
+                n.proceso_en_cpu = 0;
+            }
+        }
+    }
+
+    void terminar_proceso(int id) {
+        if (!tabla.existe(id)) {
+            std::cout << "[!] No existe proceso " << id << "\n";
+            return;
+        }
+        if (tabla.indice_heap[id] >= 0) nucleos[tabla.nucleo[id]].cola_listos.remover(id);
+        for (auto &n : nucleos)
+            if (n.proceso_en_cpu == id) n.proceso_en_cpu = 0;
+        if (tabla.estado[id] != EstadoProceso::TERMINADO) finalizados++;
+        tabla.estado[id] = EstadoProceso::TERMINADO;
+        tabla.tiempo_finalizacion[id] = tiempo_actual;
+        std::cout << "[X] Proceso " << id << " terminado manualmente.\n";
+    }
+
+    HandleProceso obtener_proceso(int id) {
+        if (!tabla.existe(id)) return {};
+        return {&tabla, id};
+    }
+    bool es_propio(HandleProceso p) const { return p.tabla == &tabla; }
+
+    void listar_procesos() {
+        std::cout << "\nID\tEstado\tRest\tInicio\tFin\tEspera";
+        if (activos > 1) std::cout << "\tCPU";
+        std::cout << "\n";
+        for (int pid = 1; pid <= tabla.cantidad(); ++pid) {
+            std::cout << pid << "\t" << nombre_estado(tabla.estado[pid]) << "\t" << tabla.tiempo_restante[pid]
+                 << "\t" << tabla.tiempo_inicio[pid] << "\t" << tabla.tiempo_finalizacion[pid]
+                 << "\t" << espera_actual(pid);
+            if (activos > 1) std::cout << "\t" << tabla.nucleo[pid];
+            std::cout << "\n";
+        }
+    }
+
+    void estadisticas_generales() {
+        std::vector<MetricasNucleo> m;
+        for (auto &n : nucleos) m.push_back(n.m);
+        imprimir_estadisticas(tabla, m, activos, tiempo_actual, capacidad_ticks);
+    }
+};
+
+
+// ------------------------- Planificador CFS -------------------------
+// Completely Fair Scheduler: cada proceso acumula vruntime = tiempo de CPU escalado por
+// 1024/peso (peso segun su nice) y siempre corre el de menor vruntime. Los listos viven en
+// un arbol rojo-negro (std::set) ordenado por (vruntime, pid): elegir, insertar y quitar
+// son O(log n) aun con miles de procesos ejecutables.
+// La rebanada de cada despacho reparte la latencia objetivo segun el peso, sin bajar de la
+// granularidad minima. Multiprocesador: un arbol por CPU, con robo del mas atrasado.
+class PlanificadorCFS {
+private:
+    // vruntime en unidades de 1/65536 de tick (nice 0): los pesos no-1024 no pierden precision
+    static constexpr long long ESCALA_VR = 1 << 16;
+    static constexpr int PESO_NICE_0 = 1024;
+
+    struct Nucleo {
+        std::set<std::pair<long long,int>> arbol; // (vruntime, pid) de los LISTO de esta CPU
+        int proceso_en_cpu = 0;         // 0 = ninguno (no esta en el arbol mientras corre)
+        int ultimo_en_cpu = 0;          // ultimo PID despachado; 0 tras terminar
+        int rebanada = 0;               // ticks que le quedan al proceso en CPU
+        long long min_vruntime = 0;     // piso monotono para ubicar llegadas
+        long long peso_total = 0;       // arbol + proceso en CPU
+        bool revisar = false;           // hubo llegadas: comprobar preempcion al iniciar el tramo
+        MetricasNucleo m;
+    };
+
+    TablaProcesos tabla;
+    // columnas propias de CFS, indexadas por PID como la tabla
+    std::vector<long long> vruntime;
+    std::vector<int8_t> nice;
+    std::vector<Nucleo> nucleos;
+    int activos;
+    long long capacidad_ticks;
+    std::priority_queue<std::pair<int,int>, std::vector<std::pair<int,int>>, std::greater<std::pair<int,int>>> llegadas_pendientes;
+    int latencia_objetivo;   // periodo en el que cada listo deberia correr una vez
+    int granularidad_minima; // rebanada minima y umbral de preempcion por llegada
+    int tiempo_actual;
+    int finalizados;
+    RegistroEventos *traza;
+
+    // Tabla de pesos de Linux (sched_prio_to_weight): cada nivel de nice ~10% de CPU
+    static int peso_de_nice(int n) {
+        static const int PESOS[40] = {
+            88761, 71755, 56483, 46273, 36291, 29154, 23254, 18705, 14949, 11916,
+            9548,  7620,  6100,  4904,  3906,  3121,  2501,  1991,  1586,  1277,
+            1024,  820,   655,   526,   423,   335,   272,   215,   172,   137,
+            110,   87,    70,    56,    45,    36,    29,    23,    18,    15,
+        };
+        return PESOS[std::max(-20, std::min(19, n)) + 20];
+    }
+
+    int peso(int pid) const { return peso_de_nice(nice[pid]); }
+    long long incremento_vr(int pid) const { return (long long)PESO_NICE_0 * ESCALA_VR / peso(pid); }
+    int vr_ticks(int pid) const { return (int)(vruntime[pid] / ESCALA_VR); }
+
+    int id_evento(int k) const { return activos > 1 ? k : -1; }
+
+    int carga(int k) const {
+        return (int)nucleos[k].arbol.size() + (nucleos[k].proceso_en_cpu ? 1 : 0);
+    }
+
+    int nucleo_menos_cargado() const {
+        int mejor = 0;
+        for (int k = 1; k < activos; ++k)
+            if (carga(k) < carga(mejor)) mejor = k;
+        return mejor;
+    }
+
+    int espera_actual(int pid) const {
+        int espera = tabla.tiempo_espera_acumulado[pid];
+        if (tabla.estado[pid] == EstadoProceso::LISTO && tabla.en_cola[pid])
+            espera += tiempo_actual - tabla.tiempo_listo[pid];
+        return espera;
+    }
+
+    // Rebanada = max(latencia, nr * granularidad) * peso / peso_total, al menos la granularidad
+    int calcular_rebanada(const Nucleo &n, int pid) const {
+        long long nr = (long long)n.arbol.size() + (n.proceso_en_cpu ? 1 : 0);
+        long long periodo = std::max((long long)latencia_objetivo, nr * granularidad_minima);
+        long long r = n.peso_total > 0 ? periodo * peso(pid) / n.peso_total : periodo;
+        return (int)std::max((long long)granularidad_minima, std::min(r, (long long)INT_MAX / 2));
+    }
+
+    // Rebanada que se renueva cuando el proceso corre solo en su CPU
+    int rebanada_sin_competencia() const { return std::max(latencia_objetivo, granularidad_minima); }
+
+    void insertar_arbol(int k, int pid) {
+        nucleos[k].arbol.insert({vruntime[pid], pid});
+        nucleos[k].peso_total += peso(pid);
+        tabla.en_cola[pid] = 1;
+        tabla.nucleo[pid] = (int16_t)k;
+    }
+
+    void quitar_arbol(int k, int pid) {
+        nucleos[k].arbol.erase({vruntime[pid], pid});
+        nucleos[k].peso_total -= peso(pid);
+        tabla.en_cola[pid] = 0;
+    }
+
+    // Llegada o reubicacion: no puede arrastrar un vruntime menor que el piso de la CPU,
+    // si no monopolizaria la CPU hasta alcanzar a los demas.
+    void encolar_listo(int pid, int instante, int k = -1) {
+        tabla.estado[pid] = EstadoProceso::LISTO;
+        if (tabla.en_cola[pid]) return;
+        if (k < 0) k = nucleo_menos_cargado();
+        vruntime[pid] = std::max(vruntime[pid], nucleos[k].min_vruntime);
+        tabla.tiempo_listo[pid] = instante;
+        insertar_arbol(k, pid);
+        nucleos[k].revisar = true;
+    }
+
+    // El proceso en CPU vuelve al arbol con su vruntime actual
+    void devolver_al_arbol(int k) {
+        Nucleo &n = nucleos[k];
+        int p = n.proceso_en_cpu;
+        n.peso_total -= peso(p);
+        n.proceso_en_cpu = 0;
+        tabla.estado[p] = EstadoProceso::LISTO;
+        tabla.tiempo_listo[p] = tiempo_actual;
+        insertar_arbol(k, p);
+    }
+
+    // Saca de la izquierda del arbol a los que dejaron de estar LISTO mientras esperaban
+    // (bloqueados por semaforo, E/S o impresora), como descartar_no_listos en RR; su espera
+    // ya se cerro al bloquearse
+    void descartar_no_listos(int k) {
+        Nucleo &n = nucleos[k];
+        while (!n.arbol.empty() && tabla.estado[n.arbol.begin()->second] != EstadoProceso::LISTO)
+            quitar_arbol(k, n.arbol.begin()->second);
+    }
+
+    // El proceso en CPU deja de competir (terminado, kill o bloqueado)
+    void retirar_de_cpu(int k) {
+        Nucleo &n = nucleos[k];
+        n.peso_total -= peso(n.proceso_en_cpu);
+        n.proceso_en_cpu = 0;
+    }
+
+    void actualizar_min_vruntime(Nucleo &n) {
+        long long minimo = LLONG_MAX;
+        if (n.proceso_en_cpu) minimo = vruntime[n.proceso_en_cpu];
+        if (!n.arbol.empty()) minimo = std::min(minimo, n.arbol.begin()->first);
+        if (minimo != LLONG_MAX) n.min_vruntime = std::max(n.min_vruntime, minimo);
+    }
+
+    void poner_en_cpu(int k, int pid) {
+        Nucleo &n = nucleos[k];
+        quitar_arbol(k, pid);
+        n.proceso_en_cpu = pid;
+        n.peso_total += peso(pid);
+        n.rebanada = calcular_rebanada(n, pid);
+        n.m.despachos++;
+        tabla.nucleo[pid] = (int16_t)k;
+        tabla.tiempo_espera_acumulado[pid] += tiempo_actual - tabla.tiempo_listo[pid];
+        if (tabla.tiempo_inicio[pid] == -1) tabla.tiempo_inicio[pid] = tiempo_actual;
+        if (tabla.response_time[pid] == -1) tabla.response_time[pid] = tiempo_actual - tabla.tiempo_llegada[pid];
+        tabla.estado[pid] = EstadoProceso::EJECUTANDO;
+        tabla.quantums_served[pid]++;
+        emitir(traza, NivelTraza::EVENTOS, TipoEvento::SELECCION_CFS, tiempo_actual, tiempo_actual, pid,
+               vr_ticks(pid), n.rebanada, 0, id_evento(k));
+    }
+
+    // CPU ociosa: toma el proceso mas atrasado (menor vruntime) del arbol mas grande.
+    // Su vruntime se traslada al piso de la CPU destino conservando su ventaja relativa.
+    bool robar(int k) {
+        int victima = -1;
+        for (int j = 0; j < activos; ++j) {
+            if (j == k) continue;
+            descartar_no_listos(j);
+            if (nucleos[j].arbol.empty()) continue;
+            if (victima < 0 || nucleos[j].arbol.size() > nucleos[victima].arbol.size()) victima = j;
+        }
+        if (victima < 0) return false;
+        int pid = nucleos[victima].arbol.begin()->second;
+        quitar_arbol(victima, pid);
+        vruntime[pid] = vruntime[pid] - nucleos[victima].min_vruntime + nucleos[k].min_vruntime;
+        insertar_arbol(k, pid);
+        nucleos[k].m.migraciones++;
+        emitir(traza, NivelTraza::EVENTOS, TipoEvento::MIGRACION, tiempo_actual, tiempo_actual, pid,
+               victima, 0, 0, k);
+        poner_en_cpu(k, pid);
+        return true;
+    }
+
+    void redimensionar_columnas() {
+        vruntime.resize(tabla.estado.size(), 0);
+        nice.resize(tabla.estado.size(), 0);
+    }
+
+public:
+    PlanificadorCFS(RegistroEventos *t = nullptr, int latencia = 24, int granularidad = 3)
+        : nucleos(1), activos(1), capacidad_ticks(0), latencia_objetivo(std::max(1, latencia)),
+          granularidad_minima(std::max(1, granularidad)), tiempo_actual(0), finalizados(0), traza(t) {
+        redimensionar_columnas();
+        tabla.reloj = &tiempo_actual;
+    }
+    // la tabla apunta al reloj propio: no se copia ni se mueve
+    PlanificadorCFS(const PlanificadorCFS &) = delete;
+    PlanificadorCFS &operator=(const PlanificadorCFS &) = delete;
+
+    int crear_proceso(int tiempo_requerido, int llegada_offset = 0, int valor_nice = 0) {
+        int llegada = sumar_reloj(tiempo_actual, llegada_offset);
+        int pid = tabla.crear(tiempo_requerido, llegada);
+        redimensionar_columnas();
+        nice[pid] = (int8_t)std::max(-20, std::min(19, valor_nice));
+        if (llegada <= tiempo_actual) encolar_listo(pid, tiempo_actual);
+        else llegadas_pendientes.push({llegada, pid});
+        return pid;
+    }
+
+    // Alta masiva desde una carga binaria (nice 0), igual que en RR y SJF
+    int crear_procesos(size_t n, const uint32_t *tiempos, const uint32_t *llegadas) {
+        tabla.reservar(tabla.cantidad() + n);
+        int primero = tabla.crear_lote(n, tiempos, llegadas, tiempo_actual);
+        redimensionar_columnas();
+        std::vector<std::pair<int,int>> futuras;
+        futuras.reserve(n);
+        sugerir_paginas_grandes(futuras);
+        for (size_t i = 0; i < n; ++i) {
+            int pid = primero + (int)i;
+            if (tabla.tiempo_llegada[pid] <= tiempo_actual) encolar_listo(pid, tiempo_actual);
+            else futuras.push_back({tabla.tiempo_llegada[pid], pid});
+        }
+        if (llegadas_pendientes.empty())
+            llegadas_pendientes = decltype(llegadas_pendientes)(std::greater<std::pair<int,int>>(), std::move(futuras));
+        else
+            for (auto &f : futuras) llegadas_pendientes.push(f);
+        return primero;
+    }
+
+    // Cambia el nice de un proceso. El peso nuevo rige desde el siguiente tick;
+    // el vruntime ya acumulado no se recalcula.
+    bool set_nice(int pid, int valor) {
+        if (!tabla.existe(pid) || tabla.estado[pid] == EstadoProceso::TERMINADO) return false;
+        valor = std::max(-20, std::min(19, valor));
+        int k = tabla.nucleo[pid];
+        bool cuenta = k >= 0 && (tabla.en_cola[pid] || nucleos[k].proceso_en_cpu == pid);
+        if (cuenta) nucleos[k].peso_total -= peso(pid);
+        nice[pid] = (int8_t)valor;
+        if (cuenta) nucleos[k].peso_total += peso(pid);
+        return true;
+    }
+    int get_nice(int pid) const { return tabla.existe(pid) ? nice[pid] : 0; }
+
+    // Latencia objetivo y granularidad minima en ticks (comando cfs). Rigen desde el proximo
+    // despacho o renovacion: la rebanada que le queda al proceso en CPU no se recalcula.
+    void set_parametros(int latencia, int granularidad) {
+        latencia_objetivo = std::max(1, latencia);
+        granularidad_minima = std::max(1, granularidad);
+    }
+    int get_latencia() const { return latencia_objetivo; }
+    int get_granularidad() const { return granularidad_minima; }
+
+    // Reencola un proceso que se desbloquea (semaforo, E/S, impresora), como en RR. Si se
+    // bloqueo y desperto sin que la CPU lo soltara, sigue corriendo.
+    void enqueue_ready(int pid) {
+        if (!tabla.existe(pid) || tabla.estado[pid] == EstadoProceso::TERMINADO) return;
+        for (int k = 0; k < activos; ++k)
+            if (nucleos[k].proceso_en_cpu == pid) {
+                tabla.estado[pid] = EstadoProceso::EJECUTANDO;
+                return;
+            }
+        if (tabla.en_cola[pid]) tabla.tiempo_listo[pid] = tiempo_actual;
+        encolar_listo(pid, tiempo_actual);
+    }
+
+    void incorporar_llegadas(int limite) {
+        while (!llegadas_pendientes.empty() && llegadas_pendientes.top().first <= limite) {
+            auto [llegada, pid] = llegadas_pendientes.top();
+            llegadas_pendientes.pop();
+            if (tabla.estado[pid] != EstadoProceso::LISTO) continue;
+            encolar_listo(pid, llegada);
+        }
+    }
+
+    // Al reducir CPUs, los procesos de las retiradas pasan a las que quedan
+    // (normalizando su vruntime al piso de la CPU destino) conservando su espera.
+    void set_nucleos(int n) {
+        n = std::max(1, n);
+        if ((int)nucleos.size() < n) nucleos.resize(n);
+        int antes = activos;
+        activos = n;
+        for (int k = n; k < antes; ++k) {
+            Nucleo &viejo = nucleos[k];
+            std::vector<int> mover;
+            if (viejo.proceso_en_cpu) {
+                int pid = viejo.proceso_en_cpu;
+                retirar_de_cpu(k);
+                if (tabla.estado[pid] == EstadoProceso::EJECUTANDO) {
+                    tabla.tiempo_listo[pid] = tiempo_actual;
+                    mover.push_back(pid);
+                }
+            }
+            while (!viejo.arbol.empty()) {
+                int pid = viejo.arbol.begin()->second;
+                quitar_arbol(k, pid);
+                mover.push_back(pid);
+            }
+            for (int pid : mover) {
+                vruntime[pid] -= viejo.min_vruntime;
+                int destino = nucleo_menos_cargado();
+                vruntime[pid] += nucleos[destino].min_vruntime;
+                encolar_listo(pid, tabla.tiempo_listo[pid], destino);
+            }
+        }
+    }
+
+    int get_nucleos() const { return activos; }
+
+    int get_tiempo() const { return tiempo_actual; }
+    bool completo() const { return finalizados == tabla.cantidad(); }
+
+    void ejecutar_hasta_terminar(GestorMarcos &gestor, int limite = INT_MAX / 2) {
+        while (!completo() && tiempo_actual < limite) avanzar_hasta_evento(limite, gestor);
+    }
+
+    ResumenPlanificador resumen() const {
+        std::vector<MetricasNucleo> m;
+        for (auto &n : nucleos) m.push_back(n.m);
+        return calcular_resumen(tabla, m, tiempo_actual, capacidad_ticks);
+    }
+
+    void tick(GestorMarcos &gestor) {
+        if (tiempo_actual < INT_MAX) avanzar_hasta_evento(tiempo_actual + 1, gestor);
+    }
+
+    int ejecutar_ticks(int n, GestorMarcos &gestor) {
+        int inicio = tiempo_actual, fin = sumar_reloj(tiempo_actual, std::max(0, n)), pasos = 0;
+        while (tiempo_actual < fin) { avanzar_hasta_evento(fin, gestor); pasos++; }
+        emitir(traza, NivelTraza::RESUMEN, TipoEvento::RUN_RESUMEN, inicio, fin, 0, pasos);
+        return fin - inicio;
+    }
+
+    // Igual que en RR, todas las CPUs avanzan juntas hasta el evento mas cercano: llegada,
+    // terminacion o fin de rebanada. Una CPU con el arbol vacio solo renueva la rebanada
+    // del mismo proceso, asi que esos vencimientos se pliegan en forma cerrada.
+    void avanzar_hasta_evento(int fin, GestorMarcos &gestor) {
+        incorporar_llegadas(tiempo_actual);
+
+        for (int k = 0; k < activos; ++k) {
+            Nucleo &n = nucleos[k];
+            if (n.proceso_en_cpu && tabla.estado[n.proceso_en_cpu] != EstadoProceso::EJECUTANDO) retirar_de_cpu(k);
+            descartar_no_listos(k);
+            // preempcion por llegada: el recien llegado lleva mas de una granularidad de ventaja
+            if (n.revisar && n.proceso_en_cpu && !n.arbol.empty()) {
+                auto [vr_izq, pid_izq] = *n.arbol.begin();
+                int p = n.proceso_en_cpu;
+                if (vruntime[p] - vr_izq > (long long)granularidad_minima * ESCALA_VR) {
+                    emitir(traza, NivelTraza::EVENTOS, TipoEvento::PREEMPCION_CFS, tiempo_actual, tiempo_actual, p,
+                           vr_ticks(p), pid_izq, 0, id_evento(k));
+                    devolver_al_arbol(k);
+                }
+            }
+            n.revisar = false;
+            if (!n.proceso_en_cpu && !n.arbol.empty()) poner_en_cpu(k, n.arbol.begin()->second);
+        }
+        if (activos > 1) {
+            for (int k = 0; k < activos; ++k)
+                if (!nucleos[k].proceso_en_cpu && !robar(k)) break;
+        }
+        // cambio de contexto: sin ASID el TLB se vacia
+        for (int k = 0; k < activos; ++k) {
+            Nucleo &n = nucleos[k];
+            if (n.proceso_en_cpu && n.proceso_en_cpu != n.ultimo_en_cpu) gestor.cambio_contexto();
+            if (n.proceso_en_cpu) n.ultimo_en_cpu = n.proceso_en_cpu;
+        }
+
+        int inicio = tiempo_actual;
+        int hasta = fin;
+        if (!llegadas_pendientes.empty()) hasta = std::min(hasta, llegadas_pendientes.top().first);
+        for (int k = 0; k < activos; ++k) {
+            Nucleo &n = nucleos[k];
+            int p = n.proceso_en_cpu;
+            if (!p) continue;
+            hasta = std::min(hasta, sumar_reloj(inicio, std::max(1, tabla.tiempo_restante[p])));
+            if (!n.arbol.empty()) hasta = std::min(hasta, sumar_reloj(inicio, std::max(1, n.rebanada)));
+        }
+
+        tiempo_actual = hasta;
+        capacidad_ticks += (long long)(hasta - inicio) * activos;
+
+        for (int k = 0; k < activos; ++k) {
+            Nucleo &n = nucleos[k];
+            int p = n.proceso_en_cpu;
+            if (!p) {
+                emitir(traza, NivelTraza::TICKS, TipoEvento::CPU_IDLE, inicio, hasta - 1, 0, 0, 0, 0, id_evento(k));
+                continue;
+            }
+            int d = hasta - inicio;
+            int renovaciones = 0;
+            int primer_fin = sumar_reloj(inicio, n.rebanada);
+            if (n.arbol.empty() && primer_fin < hasta) {
+                int largo = rebanada_sin_competencia();
+                renovaciones = (hasta - 1 - primer_fin) / largo + 1;
+                int ultimo_fin = primer_fin + (renovaciones - 1) * largo;
+                n.rebanada = largo - (hasta - ultimo_fin);
+                tabla.quantums_served[p] += renovaciones;
+                n.m.despachos += renovaciones;
+            } else {
+                n.rebanada -= d;
+            }
+            vruntime[p] += d * incremento_vr(p);
+            tabla.tiempo_restante[p] -= d;
+            n.m.ticks_ocupados += d;
+
+            emitir(traza, NivelTraza::TICKS, TipoEvento::EJECUCION_CFS, inicio + 1, tiempo_actual, p,
+                   tabla.tiempo_restante[p], vr_ticks(p), renovaciones, id_evento(k));
+            // antes de sacar al proceso: su vruntime final tambien empuja el piso
+            actualizar_min_vruntime(n);
+
+            if (tabla.tiempo_restante[p] <= 0) {
+                tabla.estado[p] = EstadoProceso::TERMINADO;
+                tabla.tiempo_finalizacion[p] = tiempo_actual;
+                int retorno = tiempo_actual - tabla.tiempo_llegada[p];
+                n.m.terminados++;
+                n.m.retorno_terminados += retorno;
+                n.m.espera_terminados += retorno - tabla.tiempo_requerido[p];
+                finalizados++;
+                emitir(traza, NivelTraza::RESUMEN, TipoEvento::TERMINACION, tiempo_actual, tiempo_actual, p,
+                       0, 0, 0, id_evento(k));
+                gestor.liberar_proceso(p);
+                n.ultimo_en_cpu = 0;
+                retirar_de_cpu(k);
+            } else if (n.rebanada <= 0) {
+                if (n.arbol.empty()) {
+                    // solo en su CPU: sigue corriendo con una rebanada nueva
+                    n.rebanada = rebanada_sin_competencia();
+                    tabla.quantums_served[p]++;
+                    n.m.despachos++;
+                } else {
+                    emitir(traza, NivelTraza::EVENTOS, TipoEvento::PREEMPCION_CFS, tiempo_actual, tiempo_actual, p,
+                           vr_ticks(p), 0, 0, id_evento(k));
+                    devolver_al_arbol(k);
+                }
+            }
+        }
+    }
+
+    void terminar_proceso(int id) {
+        if (!tabla.existe(id)) {
+            std::cout << "[!] No existe proceso " << id << "\n";
+            return;
+        }
+        if (tabla.en_cola[id]) quitar_arbol(tabla.nucleo[id], id);
+        for (int k = 0; k < (int)nucleos.size(); ++k)
+            if (nucleos[k].proceso_en_cpu == id) retirar_de_cpu(k);
+        if (tabla.estado[id] != EstadoProceso::TERMINADO) finalizados++;
+        tabla.estado[id] = EstadoProceso::TERMINADO;
+        tabla.tiempo_finalizacion[id] = tiempo_actual;
+        std::cout << "[X] Proceso " << id << " terminado manualmente.\n";
+    }
+
+    HandleProceso obtener_proceso(int id) {
+        if (!tabla.existe(id)) return {};
+        return {&tabla, id};
+    }
+    bool es_propio(HandleProceso p) const { return p.tabla == &tabla; }
+
+    void listar_procesos() {
+        std::cout << "\nID\tEstado\tRest\tInicio\tFin\tEspera\tResp\tNice\tVRuntime";
+        if (activos > 1) std::cout << "\tCPU";
+        std::cout << "\n" << std::fixed << std::setprecision(2);
+        for (int pid = 1; pid <= tabla.cantidad(); ++pid) {
+            std::cout << pid << "\t" << nombre_estado(tabla.estado[pid]) << "\t" << tabla.tiempo_restante[pid] << "\t"
+                 << tabla.tiempo_inicio[pid] << "\t" << tabla.tiempo_finalizacion[pid] << "\t"
+                 << espera_actual(pid) << "\t" << tabla.response_time[pid] << "\t" << (int)nice[pid] << "\t"
+                 << (double)vruntime[pid] / ESCALA_VR;
+            if (activos > 1) std::cout << "\t" << tabla.nucleo[pid];
+            std::cout << "\n";
+        }
+    }
+
+    // Ademas del resumen comun: equidad de Jain sobre el servicio normalizado por peso
+    // (CPU * 1024/peso por tick en el sistema) de los procesos que siguen compitiendo.
+    // 1.0 = reparto perfectamente proporcional a los pesos.
+    void estadisticas_generales() {
+        std::vector<MetricasNucleo> m;
+        for (auto &n : nucleos) m.push_back(n.m);
+        imprimir_estadisticas(tabla, m, activos, tiempo_actual, capacidad_ticks);
+
+        double suma = 0, suma_cuadrados = 0;
+        long long vr_min = LLONG_MAX, vr_max = LLONG_MIN;
+        int competidores = 0;
+        for (int pid = 1; pid <= tabla.cantidad(); ++pid) {
+            EstadoProceso e = tabla.estado[pid];
+            if (e != EstadoProceso::LISTO && e != EstadoProceso::EJECUTANDO) continue;
+            int en_sistema = tiempo_actual - tabla.tiempo_llegada[pid];
+            if (en_sistema <= 0) continue;
+            double servicio = (double)(tabla.tiempo_requerido[pid] - tabla.tiempo_restante[pid]) * PESO_NICE_0 / peso(pid);
+            double x = servicio / en_sistema;
+            suma += x;
+            suma_cuadrados += x * x;
+            competidores++;
+            vr_min = std::min(vr_min, vruntime[pid]);
+            vr_max = std::max(vr_max, vruntime[pid]);
+        }
+        std::cout << "[CFS] latencia objetivo=" << latencia_objetivo << " granularidad minima=" << granularidad_minima << "\n";
+        if (competidores == 0 || suma_cuadrados == 0) {
+            std::cout << "Equidad (Jain): sin procesos compitiendo\n";
+            return;
+        }
+        std::cout << std::fixed << std::setprecision(4) << "Equidad (Jain) entre " << competidores << " procesos: "
+             << suma * suma / (competidores * suma_cuadrados) << "\n";
+        std::cout << std::setprecision(2) << "Dispersion de vruntime (max - min): " << (double)(vr_max - vr_min) / ESCALA_VR
+             << " ticks\n";
+    }
+};
+
+
+// ------------------------- Benchmark SJF (sort vs heap) -------------------------
+// Compara el despacho anterior (remove_if + sort + erase del frente en cada seleccion)
+// contra el heap indexado. El metodo antiguo se mide en pocos despachos y se extrapola.
+void benchmark_sjf(int n, int despachos_antiguo = 20);
+
+
+// ------------------------- Semáforo simulado -------------------------
+struct MetricasSemaforo {
+    long long esperas = 0;       // wait totales (procesos simulados e hilos)
+    long long bloqueos = 0;      // wait que no encontraron valor y tuvieron que esperar
+    long long signals = 0;
+    long long despertados = 0;   // procesos simulados devueltos a LISTO por un signal
+    int max_cola = 0;            // maximo de esperando a la vez (procesos + hilos)
+    double bloqueado_total_us = 0, bloqueado_max_us = 0; // tiempo real de los hilos bloqueados
+};
+
+// Semaforo contador seguro entre hilos. Camino rapido: CAS sobre 'valor' sin tomar el mutex.
+// Camino lento: mutex + variable de condicion (futex en Linux) para hilos reales, o la cola
+// de procesos simulados, que pasan a BLOQUEADO y vuelven a LISTO con el signal.
+// 'esperando' se incrementa antes de revisar 'valor' bajo el mutex, y signal incrementa
+// 'valor' antes de leer 'esperando': o el que espera ve el valor nuevo o signal lo despierta.
+class SemaforoSimulado {
+private:
+    using reloj = std::chrono::steady_clock;
+
+    std::atomic<int> valor;
+    std::atomic<int> esperando{0}; // procesos en cola + hilos dormidos
+    std::atomic<long long> esperas{0}, signals{0};
+    mutable std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<HandleProceso> cola_bloqueados;
+    int hilos_dormidos = 0;
+    long long bloqueos = 0, despertados = 0;
+    int max_cola = 0;
+    double bloqueado_total_us = 0, bloqueado_max_us = 0;
+
+    bool tomar_rapido() {
+        int v = valor.load();
+        while (v > 0)
+            if (valor.compare_exchange_weak(v, v - 1)) return true;
+        return false;
+    }
+
+    // Con el mutex tomado: el primer proceso vivo de la cola vuelve a LISTO. Los terminados
+    // (kill) mientras esperaban se descartan sin consumir el signal; vacio si no queda ninguno.
+    HandleProceso despertar() {
+        while (!cola_bloqueados.empty()) {
+            auto p = cola_bloqueados.front();
+            cola_bloqueados.pop_front();
+            esperando.fetch_sub(1);
+            if (p.estado() == EstadoProceso::TERMINADO) continue;
+            despertados++;
+            p.estado() = EstadoProceso::LISTO;
+            return p;
+        }
+        return {};
+    }
+
+    // Con el mutex tomado
+    void anotar_espera() {
+        bloqueos++;
+        int en_cola = (int)cola_bloqueados.size() + hilos_dormidos;
+        if (en_cola > max_cola) max_cola = en_cola;
+    }
+
+public:
+    SemaforoSimulado(int v = 1): valor(v) {}
+    SemaforoSimulado(const SemaforoSimulado &) = delete;
+    SemaforoSimulado &operator=(const SemaforoSimulado &) = delete;
+
+    // Wait: si valor>0 decrementa, si no, bloquea al proceso (cambia su estado).
+    // Devuelve false si el proceso quedo bloqueado.
+    bool wait(HandleProceso p) {
+        esperas.fetch_add(1, std::memory_order_relaxed);
+        if (tomar_rapido()) return true;
+        std::lock_guard<std::mutex> lk(mtx);
+        esperando.fetch_add(1);
+        if (tomar_rapido()) {
+            esperando.fetch_sub(1);
+            return true;
+        }
+        p.bloquear();
+        cola_bloqueados.push_back(p);
+        anotar_espera();
+        return false;
+    }
+
+    // Saca de la cola a un proceso que deja de esperar (kill). true si estaba en ella.
+    bool retirar(HandleProceso p) {
+        std::lock_guard<std::mutex> lk(mtx);
+        auto it = std::find_if(cola_bloqueados.begin(), cola_bloqueados.end(), [&](const HandleProceso &q) {
+            return q.tabla == p.tabla && q.pid == p.pid;
+        });
+        if (it == cola_bloqueados.end()) return false;
+        cola_bloqueados.erase(it);
+        esperando.fetch_sub(1);
+        return true;
+    }
+
+    // Wait de un hilo real: bloquea al hilo hasta que haya valor
+    void wait() {
+        esperas.fetch_add(1, std::memory_order_relaxed);
+        if (tomar_rapido()) return;
+        std::unique_lock<std::mutex> lk(mtx);
+        esperando.fetch_add(1);
+        if (!tomar_rapido()) {
+            hilos_dormidos++;
+            anotar_espera();
+            auto t0 = reloj::now();
+            cv.wait(lk, [&] { return tomar_rapido(); });
+            hilos_dormidos--;
+            double us = std::chrono::duration<double, std::micro>(reloj::now() - t0).count();
+            bloqueado_total_us += us;
+            bloqueado_max_us = std::max(bloqueado_max_us, us);
+        }
+        esperando.fetch_sub(1);
+    }
+
+    bool try_wait() {
+        esperas.fetch_add(1, std::memory_order_relaxed);
+        return tomar_rapido();
+    }
+
+    // Signal: si hay procesos bloqueados, despierta al primero; si no, incrementa valor
+    // (y despierta a un hilo si alguno duerme). El llamador reencola al proceso devuelto.
+    HandleProceso signal() {
+        signals.fetch_add(1, std::memory_order_relaxed);
+        if (esperando.load() == 0) {
+            valor.fetch_add(1);
+            if (esperando.load() == 0) return {};
+            // alguien empezo a esperar entre medio: si es un proceso y el valor sigue libre, es suyo
+            std::lock_guard<std::mutex> lk(mtx);
+            if (!cola_bloqueados.empty() && tomar_rapido()) {
+                if (HandleProceso p = despertar()) return p;
+                valor.fetch_add(1); // solo habia terminados: el valor vuelve
+            }
+            cv.notify_one();
+            return {};
+        }
+        std::lock_guard<std::mutex> lk(mtx);
+        if (HandleProceso p = despertar()) return p;
+        valor.fetch_add(1);
+        cv.notify_one();
+        return {};
+    }
+
+    int get_valor() const { return valor.load(); }
+    size_t bloqueados() const {
+        std::lock_guard<std::mutex> lk(mtx);
+        return cola_bloqueados.size();
+    }
+
+    MetricasSemaforo metricas() const {
+        std::lock_guard<std::mutex> lk(mtx);
+        MetricasSemaforo m;
+        m.esperas = esperas.load();
+        m.signals = signals.load();
+        m.bloqueos = bloqueos;
+        m.despertados = despertados;
+        m.max_cola = max_cola;
+        m.bloqueado_total_us = bloqueado_total_us;
+        m.bloqueado_max_us = bloqueado_max_us;
+        return m;
+    }
+};
+
+// Tabla de 'semstat': una fila por semaforo con nombre
+void mostrar_semaforos(const std::vector<std::pair<std::string, const SemaforoSimulado *>> &sems);
+
+
+// ------------------------- Productor-Consumidor simulado -------------------------
+class ProductorConsumidorSimulado {
+private:
+    std::deque<int> buffer;
+    size_t capacidad;
+    SemaforoSimulado sem_vacio; // cuenta de vacios (capacidad)
+    SemaforoSimulado sem_item;  // cuenta de items disponibles
+    RegistroEventos *traza;
+    ReencolarProceso reencolar; // para los procesos bloqueados con sem_wait que un signal despierta
+
+    void signal(SemaforoSimulado &s) {
+        HandleProceso p = s.signal();
+        if (p && reencolar) reencolar(p);
+    }
+public:
+    ProductorConsumidorSimulado(size_t cap=5, RegistroEventos *t = nullptr)
+        : capacidad(cap), sem_vacio((int)cap), sem_item(0), traza(t) {}
+
+    // Produce de forma simulada: si buffer lleno => bloquea (retornamos false)
+    bool producir_simulado(int item) {
+        // si hay hueco inmediato (sem_vacio lleva la cuenta de huecos)
+        if (sem_vacio.try_wait()) {
+            buffer.push_back(item);
+            // signal item
+            signal(sem_item);
+            emitir(traza, NivelTraza::EVENTOS, TipoEvento::SYNC_PRODUCIDO, 0, 0, 0, item, (int)buffer.size());
+            return true;
+        } else {
+            emitir(traza, NivelTraza::EVENTOS, TipoEvento::SYNC_LLENO, 0, 0, 0);
+            return false;
+        }
+    }
+
+    // Consume de forma simulada: si buffer vacio => bloquea (retornamos false)
+    bool consumir_simulado() {
+        if (sem_item.try_wait()) {
+            int item = buffer.front();
+            buffer.pop_front();
+            signal(sem_vacio);
+            emitir(traza, NivelTraza::EVENTOS, TipoEvento::SYNC_CONSUMIDO, 0, 0, 0, item, (int)buffer.size());
+            return true;
+        } else {
+            emitir(traza, NivelTraza::EVENTOS, TipoEvento::SYNC_VACIO, 0, 0, 0);
+            return false;
+        }
+    }
+
+    void estado_buffer() const {
+        std::cout << "[SYNC] Elementos en buffer: " << buffer.size() << " / " << capacidad << "\n";
+    }
+
+    void set_reencolar(ReencolarProceso r) { reencolar = std::move(r); }
+    SemaforoSimulado &semaforo_vacio() { return sem_vacio; }
+    SemaforoSimulado &semaforo_item() { return sem_item; }
+};
+
+
+// ------------------------- Productor-Consumidor con hilos reales -------------------------
+// N productores y M consumidores reales contra un buffer acotado, con tres diseños:
+//   SPSC:  anillo sin locks de un productor y un consumidor (un anillo por pareja)
+//   MPMC:  anillo sin locks con numero de secuencia por celda (cola acotada de Vyukov)
+//   MUTEX: deque + mutex + semaforos de vacios e items, el diseño del modo simulado
+enum class TipoBufferPC : uint8_t { SPSC, MPMC, MUTEX };
+const char *nombre_buffer_pc(TipoBufferPC t);
+bool buffer_pc_desde_texto(const std::string &s, TipoBufferPC &t);
+
+// Anillo de un productor y un consumidor: cada lado escribe solo su indice y guarda una copia
+// del indice del otro, que relee (una carga entre nucleos) solo si el anillo parece lleno o vacio.
+class AnilloSPSC {
+private:
+    std::vector<long long> celdas;
+    size_t mascara;
+    alignas(64) std::atomic<size_t> cabeza{0}; // proxima celda a leer (escribe el consumidor)
+    size_t cola_vista = 0;                // copia de 'cola' del consumidor
+    alignas(64) std::atomic<size_t> cola{0};   // proxima celda a escribir (escribe el productor)
+    size_t cabeza_vista = 0;              // copia de 'cabeza' del productor
+
+public:
+    explicit AnilloSPSC(size_t capacidad) {
+        size_t cap = 1;
+        while (cap < capacidad) cap <<= 1;
+        celdas.assign(cap, 0);
+        mascara = cap - 1;
+    }
+
+    bool encolar(long long v) {
+        size_t c = cola.load(std::memory_order_relaxed);
+        if (c - cabeza_vista == celdas.size()) {
+            cabeza_vista = cabeza.load(std::memory_order_acquire);
+            if (c - cabeza_vista == celdas.size()) return false;
+        }
+        celdas[c & mascara] = v;
+        cola.store(c + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool desencolar(long long &v) {
+        size_t h = cabeza.load(std::memory_order_relaxed);
+        if (h == cola_vista) {
+            cola_vista = cola.load(std::memory_order_acquire);
+            if (h == cola_vista) return false;
+        }
+        v = celdas[h & mascara];
+        cabeza.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacidad() const { return celdas.size(); }
+};
+
+// Anillo de varios productores y consumidores: cada celda lleva un numero de secuencia que dice
+// si esta libre para la vuelta actual del productor o lista para el consumidor; los hilos solo
+// compiten por el CAS del indice. 'reintentos' cuenta los CAS perdidos contra otro hilo.
+class AnilloMPMC {
+private:
+    struct Celda {
+        std::atomic<size_t> secuencia;
+        long long valor;
+    };
+    std::unique_ptr<Celda[]> celdas;
+    size_t mascara;
+    alignas(64) std::atomic<size_t> pos_encolar{0};
+    alignas(64) std::atomic<size_t> pos_desencolar{0};
+
+public:
+    explicit AnilloMPMC(size_t capacidad) {
+        size_t cap = 2;
+        while (cap < capacidad) cap <<= 1;
+        celdas.reset(new Celda[cap]);
+        for (size_t i = 0; i < cap; ++i) celdas[i].secuencia.store(i, std::memory_order_relaxed);
+        mascara = cap - 1;
+    }
+
+    bool encolar(long long v, long long &reintentos) {
+        size_t pos = pos_encolar.load(std::memory_order_relaxed);
+        Celda *c;
+        for (;;) {
+            c = &celdas[pos & mascara];
+            intptr_t dif = (intptr_t)c->secuencia.load(std::memory_order_acquire) - (intptr_t)pos;
+            if (dif == 0) {
+                if (pos_encolar.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                reintentos++;
+            } else if (dif < 0) {
+                return false; // lleno: la celda todavia tiene el dato de la vuelta anterior
+            } else {
+                pos = pos_encolar.load(std::memory_order_relaxed);
+            }
+        }
+        c->valor = v;
+        c->secuencia.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool desencolar(long long &v, long long &reintentos) {
+        size_t pos = pos_desencolar.load(std::memory_order_relaxed);
+        Celda *c;
+        for (;;) {
+            c = &celdas[pos & mascara];
+            intptr_t dif = (intptr_t)c->secuencia.load(std::memory_order_acquire) - (intptr_t)(pos + 1);
+            if (dif == 0) {
+                if (pos_desencolar.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                reintentos++;
+            } else if (dif < 0) {
+                return false; // vacio
+            } else {
+                pos = pos_desencolar.load(std::memory_order_relaxed);
+            }
+        }
+        v = c->valor;
+        c->secuencia.store(pos + mascara + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacidad() const { return mascara + 1; }
+};
+
+// Linea base: el buffer del modo simulado con espera real. 'reintentos' cuenta las veces que
+// el mutex del buffer estaba tomado.
+class BufferMutexSemaforo {
+private:
+    std::deque<long long> buffer;
+    std::mutex mtx;
+
+    void tomar(long long &reintentos) {
+        if (!mtx.try_lock()) {
+            reintentos++;
+            mtx.lock();
+        }
+    }
+
+public:
+    SemaforoSimulado vacios, items;
+
+    explicit BufferMutexSemaforo(size_t capacidad) : vacios((int)capacidad), items(0) {}
+
+    void encolar(long long v, long long &reintentos) {
+        vacios.wait();
+        tomar(reintentos);
+        buffer.push_back(v);
+        mtx.unlock();
+        items.signal();
+    }
+
+    long long desencolar(long long &reintentos) {
+        items.wait();
+        tomar(reintentos);
+        long long v = buffer.front();
+        buffer.pop_front();
+        mtx.unlock();
+        vacios.signal();
+        return v;
+    }
+};
+
+struct ParametrosPC {
+    TipoBufferPC tipo = TipoBufferPC::MPMC;
+    int productores = 2;
+    int consumidores = 2;
+    size_t capacidad = 1024;      // los anillos la redondean a potencia de 2
+    long long items = 1000000;    // total entre todos los productores
+};
+
+struct ResultadoPC {
+    double segundos = 0;
+    long long items = 0;
+    double ops_por_segundo = 0;
+    double p50_ns = 0, p99_ns = 0; // latencia de encolado, muestreada 1 de cada 16
+    long long reintentos = 0;      // CAS perdidos (anillos) o mutex ocupado (linea base)
+    long long lleno = 0;           // encolados que encontraron el buffer lleno
+    long long vacio = 0;           // desencolados que lo encontraron vacio
+    bool verificado = false;       // cada item se consumio exactamente una vez (cantidad y suma)
+};
+
+// SPSC requiere productores == consumidores (cada pareja tiene su anillo)
+ResultadoPC ejecutar_productor_consumidor(const ParametrosPC &par);
+void mostrar_resultados_pc(const ParametrosPC &par, const std::vector<std::pair<TipoBufferPC, ResultadoPC>> &res);
+
+
+// ------------------------- Cena de los Filosofos (simulada) ------------------------- //
+class FilosofoSimulado {
+private:
+    int id;
+    HandleProceso proceso;
+    SemaforoSimulado* tenedor_izq;
+    SemaforoSimulado* tenedor_der;
+    RegistroEventos *traza;
+
+    enum Accion { PENSANDO, INTENTA, COMIENDO, SUELTA, BLOQUEADO };
+    void evento(int ronda, Accion a) { emitir(traza, NivelTraza::EVENTOS, TipoEvento::FILOSOFO, ronda, ronda, id, a); }
+
+public:
+    FilosofoSimulado(int _id, HandleProceso p, 
+                     SemaforoSimulado* izq, SemaforoSimulado* der, RegistroEventos *t = nullptr)
+        : id(_id), proceso(p), tenedor_izq(izq), tenedor_der(der), traza(t) {}
+
+    // pausa_ms: tiempo real que pasa pensando y comiendo (0 = sin pausas)
+    void ciclo(int ronda = 0, int pausa_ms = 0) {
+        evento(ronda, PENSANDO);
+        if (pausa_ms > 0) std::this_thread::sleep_for(std::chrono::milliseconds(pausa_ms));
+
+        evento(ronda, INTENTA);
+        tenedor_izq->wait(proceso);
+        tenedor_der->wait(proceso);
+
+        if (proceso.estado() != EstadoProceso::BLOQUEADO) {
+            proceso.estado() = EstadoProceso::EJECUTANDO;
+            evento(ronda, COMIENDO);
+            if (pausa_ms > 0) std::this_thread::sleep_for(std::chrono::milliseconds(pausa_ms));
+
+            tenedor_izq->signal();
+            tenedor_der->signal();
+            proceso.estado() = EstadoProceso::LISTO;
+            evento(ronda, SUELTA);
+        } else {
+            evento(ronda, BLOQUEADO);
+        }
+    }
+
+    std::string estado() const { return nombre_estado(proceso.estado()); }
+    int getId() const { return proceso.pid; }
+};
+
+
+// ------------------------- Simulacion de la cena -------------------------
+void simular_cena_filosofos(int N = 5, int rondas = 3, RegistroEventos *traza = nullptr, int pausa_ms = 0);
+
+
+// ------------------------- Cena de los Filosofos con hilos reales -------------------------
+// Un hilo por filosofo; el tenedor i queda a la izquierda del filosofo i. Estrategias:
+//   INGENUA:      izquierdo y luego derecho (puede bloquearse; sirve para probar el detector)
+//   ORDEN:        primero el tenedor de menor indice (orden global de recursos)
+//   CAMARERO:     un semaforo deja sentarse a lo sumo N-1 filosofos a la vez
+//   CHANDY_MISRA: tenedores limpios/sucios; un filosofo con hambre cede solo los sucios
+// Un vigilante arma el grafo de espera (filosofo -> dueño del tenedor que espera) y, si ve un
+// ciclo sin comidas nuevas, declara deadlock y aborta la corrida.
+enum class EstrategiaCena : uint8_t { INGENUA, ORDEN, CAMARERO, CHANDY_MISRA };
+const char *nombre_estrategia_cena(EstrategiaCena e);
+bool estrategia_cena_desde_texto(const std::string &s, EstrategiaCena &e);
+
+struct ParametrosCena {
+    EstrategiaCena estrategia = EstrategiaCena::ORDEN;
+    int filosofos = 5;
+    int comidas = 1000;    // por filosofo
+    int pensar_us = 0;     // pausas reales opcionales (0 = sin dormir)
+    int comer_us = 0;
+};
+
+struct ResultadoCena {
+    double segundos = 0;
+    long long comidas = 0;         // completadas (menos que las pedidas si hubo deadlock)
+    double comidas_por_segundo = 0;
+    double espera_media_us = 0;    // desde que tiene hambre hasta que come
+    double espera_max_us = 0;      // la peor espera de cualquier filosofo (inanicion)
+    int filosofo_espera_max = -1;
+    bool deadlock = false;
+    std::vector<int> ciclo;             // filosofos del ciclo de espera detectado
+};
+
+ResultadoCena ejecutar_cena_hilos(const ParametrosCena &par);
+void mostrar_resultados_cena(const ParametrosCena &par, const std::vector<std::pair<EstrategiaCena, ResultadoCena>> &res);
+
+
+// ------------------------- Solicitud de E/S con prioridad -------------------------
+struct SolicitudIO {
+    int prioridad;
+    HandleProceso proceso;
+    int duracion;
+    int llegada;        // tick del gestor en que se pidio
+    uint64_t secuencia; // desempate: a igual prioridad, en orden de llegada
+
+    bool operator<(const SolicitudIO& other) const {
+        // prioridad más alta -> primero (menor numero = mayor prioridad)
+        if (prioridad != other.prioridad) return prioridad > other.prioridad;
+        return secuencia > other.secuencia;
+    }
+};
+
+
+// ------------------------- Rueda de tiempos jerarquica -------------------------
+// 4 niveles de 256 ranuras (2^32 ticks). Un evento a d ticks va al nivel mas bajo donde d entra;
+// cuando un nivel da la vuelta, la ranura que toca del nivel de arriba se reparte hacia abajo.
+// Avanzar un tick cuesta O(eventos que vencen) mas la cascada amortizada, sin importar
+// cuantos eventos haya programados. Los nodos se reciclan en una lista libre.
+class RuedaTiempos {
+private:
+    static constexpr int BITS = 8, RANURAS = 1 << BITS, NIVELES = 4;
+    struct Nodo {
+        uint32_t vence;
+        int dato;
+        int siguiente;
+    };
+    std::vector<Nodo> nodos;
+    int libre = -1;
+    std::array<std::array<int, RANURAS>, NIVELES> ranuras; // cabeza de cada lista (-1 = vacia)
+    uint32_t ahora = 0;
+    size_t pendientes = 0;
+
+    void colocar(int i) {
+        uint32_t vence = nodos[i].vence, d = vence - ahora;
+        int nivel = d < (1u << BITS) ? 0 : d < (1u << 2 * BITS) ? 1 : d < (1u << 3 * BITS) ? 2 : 3;
+        int r = (vence >> (nivel * BITS)) & (RANURAS - 1);
+        nodos[i].siguiente = ranuras[nivel][r];
+        ranuras[nivel][r] = i;
+    }
+
+public:
+    RuedaTiempos() {
+        for (auto &nivel : ranuras) nivel.fill(-1);
+    }
+
+    // 'vence' debe ser posterior al instante actual
+    void programar(uint32_t vence, int dato) {
+        int i;
+        if (libre >= 0) {
+            i = libre;
+            libre = nodos[i].siguiente;
+        } else {
+            i = (int)nodos.size();
+            nodos.push_back({});
+        }
+        nodos[i] = {vence, dato, -1};
+        colocar(i);
+        pendientes++;
+    }
+
+    // Avanza un tick y agrega a 'vencidos' los datos de los eventos que vencen en el nuevo instante
+    void avanzar(std::vector<int> &vencidos) {
+        ahora++;
+        for (int nivel = 1; nivel < NIVELES; ++nivel) {
+            if (ahora & ((1u << (nivel * BITS)) - 1)) break;
+            int r = (ahora >> (nivel * BITS)) & (RANURAS - 1);
+            int i = ranuras[nivel][r];
+            ranuras[nivel][r] = -1;
+            while (i >= 0) {
+                int sig = nodos[i].siguiente;
+                colocar(i);
+                i = sig;
+            }
+        }
+        int r = ahora & (RANURAS - 1);
+        int i = ranuras[0][r];
+        ranuras[0][r] = -1;
+        while (i >= 0) {
+            int sig = nodos[i].siguiente;
+            vencidos.push_back(nodos[i].dato);
+            nodos[i].siguiente = libre;
+            libre = i;
+            pendientes--;
+            i = sig;
+        }
+    }
+
+    uint32_t get_ahora() const { return ahora; }
+    size_t programados() const { return pendientes; }
+};
+
+
+// ------------------------- Histograma de latencias -------------------------
+// Cubetas log-lineales: valores < 16 exactos, despues 8 cubetas por potencia de 2 (error <= 12.5%).
+// Crece solo hasta la cubeta mas alta usada, asi que miles de dispositivos cuestan poco.
+struct HistogramaLatencia {
+    std::vector<uint32_t> cubetas;
+    long long n = 0, suma = 0;
+    int maximo = 0;
+
+    static int cubeta(int v) {
+        if (v < 16) return v;
+        int e = 31 - __builtin_clz((unsigned)v);
+        return 16 + (e - 4) * 8 + ((v >> (e - 3)) & 7);
+    }
+    static int tope(int c) { // mayor valor que cae en la cubeta c
+        if (c < 16) return c;
+        int e = (c - 16) / 8 + 4, sub = (c - 16) % 8;
+        return ((8 + sub) << (e - 3)) + (1 << (e - 3)) - 1;
+    }
+
+    void agregar(int v) {
+        int c = cubeta(std::max(0, v));
+        if ((int)cubetas.size() <= c) cubetas.resize(c + 1, 0);
+        cubetas[c]++;
+        n++;
+        suma += v;
+        if (v > maximo) maximo = v;
+    }
+    void sumar(const HistogramaLatencia &o) {
+        if (cubetas.size() < o.cubetas.size()) cubetas.resize(o.cubetas.size(), 0);
+        for (size_t c = 0; c < o.cubetas.size(); ++c) cubetas[c] += o.cubetas[c];
+        n += o.n;
+        suma += o.suma;
+        if (o.maximo > maximo) maximo = o.maximo;
+    }
+    int percentil(double q) const {
+        if (n == 0) return 0;
+        long long objetivo = (long long)ceil(q * n), acumulado = 0;
+        for (size_t c = 0; c < cubetas.size(); ++c) {
+            acumulado += cubetas[c];
+            if (acumulado >= objetivo) return std::min(tope((int)c), maximo);
+        }
+        return maximo;
+    }
+    double media() const { return n ? (double)suma / n : 0.0; }
+};
+
+
+// ------------------------- Dispositivos Simulados (E/S con prioridad) -------------------------
+enum class TipoDispositivo : uint8_t { DISCO, RED, USB, OTRO };
+const char *nombre_tipo_dispositivo(TipoDispositivo t);
+bool tipo_dispositivo_desde_texto(const std::string &s, TipoDispositivo &t);
+
+// Un dispositivo no lleva reloj: el gestor le avisa cuando empieza y termina cada solicitud.
+// Una solicitud que llega a un dispositivo libre empieza en el mismo tick, y al terminar una
+// la siguiente de la cola arranca en ese mismo tick (no se pierde un tick en tomarla).
+class DispositivoSimulado {
+private:
+    std::string nombre;
+    TipoDispositivo tipo;
+    std::priority_queue<SolicitudIO> cola;
+    std::optional<SolicitudIO> en_ejecucion;
+    RegistroEventos *traza;
+    int id_nombre; // nombre registrado en la tabla de textos de la traza
+
+    // metricas
+    int creado;
+    int inicio_actual = 0;
+    long long ticks_ocupado = 0, atendidas = 0;
+    size_t cola_max = 0;
+    long long area_cola = 0; // integral de la cola en el tiempo, para la media
+    int ultimo_cambio;
+    HistogramaLatencia latencias;
+
+    void cambio_cola(int ahora) {
+        area_cola += (long long)cola.size() * (ahora - ultimo_cambio);
+        ultimo_cambio = ahora;
+    }
+
+public:
+    DispositivoSimulado(std::string n, TipoDispositivo t, RegistroEventos *tr = nullptr, int ahora = 0)
+        : nombre(std::move(n)), tipo(t), traza(tr),
+          id_nombre(tr ? tr->texto(nombre) : -1), creado(ahora), ultimo_cambio(ahora) {}
+
+    // Encola la solicitud; devuelve true si el dispositivo estaba libre y la empieza ya
+    bool solicitar(const SolicitudIO &req, int ahora) {
+        req.proceso.bloquear();
+        emitir(traza, NivelTraza::EVENTOS, TipoEvento::IO_SOLICITUD, ahora, ahora, req.proceso.pid,
+               id_nombre, req.duracion, req.prioridad);
+        cambio_cola(ahora);
+        cola.push(req);
+        cola_max = std::max(cola_max, cola.size());
+        return !en_ejecucion && iniciar_siguiente(ahora);
+    }
+
+    // Toma la siguiente solicitud de la cola; el gestor programa su fin a ahora + duracion()
+    bool iniciar_siguiente(int ahora) {
+        if (cola.empty()) return false;
+        cambio_cola(ahora);
+        en_ejecucion = cola.top();
+        cola.pop();
+        inicio_actual = ahora;
+        emitir(traza, NivelTraza::EVENTOS, TipoEvento::IO_INICIO, ahora, ahora, en_ejecucion->proceso.pid, id_nombre);
+        return true;
+    }
+
+    int duracion() const { return en_ejecucion ? en_ejecucion->duracion : 0; }
+
+    // Fin de la solicitud en curso: el proceso vuelve a LISTO y se devuelve para que el gestor
+    // lo reencole. Uno terminado (kill) mientras esperaba no revive: handle vacio.
+    HandleProceso terminar(int ahora) {
+        if (!en_ejecucion) return {};
+        HandleProceso p = en_ejecucion->proceso;
+        emitir(traza, NivelTraza::EVENTOS, TipoEvento::IO_FIN, ahora, ahora, p.pid, id_nombre);
+        ticks_ocupado += ahora - inicio_actual;
+        atendidas++;
+        latencias.agregar(ahora - en_ejecucion->llegada);
+        en_ejecucion.reset();
+        if (p.estado() == EstadoProceso::TERMINADO) return {};
+        p.estado() = EstadoProceso::LISTO;
+        return p;
+    }
+
+    const std::string &get_nombre() const { return nombre; }
+    TipoDispositivo get_tipo() const { return tipo; }
+    bool ocupado() const { return en_ejecucion.has_value(); }
+    size_t en_cola() const { return cola.size(); }
+    size_t get_cola_max() const { return cola_max; }
+    long long get_atendidas() const { return atendidas; }
+    const HistogramaLatencia &get_latencias() const { return latencias; }
+    double utilizacion(int ahora) const {
+        long long ocupado_total = ticks_ocupado + (en_ejecucion ? ahora - inicio_actual : 0);
+        return ahora > creado ? (double)ocupado_total / (ahora - creado) : 0.0;
+    }
+    double cola_media(int ahora) const {
+        long long area = area_cola + (long long)cola.size() * (ahora - ultimo_cambio);
+        return ahora > creado ? (double)area / (ahora - creado) : 0.0;
+    }
+
+    void estado(int ahora) const;
+};
+
+
+// --------------- Gestor Dispositivos (Simulados) ------------------ //
+// Dispositivos creados en tiempo de ejecucion con handle entero (indice). Cada dispositivo
+// ocupado tiene un solo evento en la rueda (el fin de su solicitud en curso), asi que un tick
+// solo toca los dispositivos que terminan en el; las solicitudes en espera viven en la cola
+// de cada dispositivo y no cuestan nada por tick.
+class GestorDispositivos {
+private:
+    std::vector<DispositivoSimulado> dispositivos;
+    std::unordered_map<std::string, int> por_nombre;
+    RuedaTiempos rueda;
+    std::vector<int> vencidos;
+    int tiempo = 0;
+    uint64_t secuencia = 0;
+    size_t en_espera = 0; // solicitudes encoladas o en curso, entre todos los dispositivos
+    ReencolarProceso reencolar; // devuelve al planificador a los que terminan su E/S
+    RegistroEventos *traza;
+
+    void iniciar(int d) {
+        rueda.programar((uint32_t)(tiempo + dispositivos[d].duracion()), d);
+    }
+
+public:
+    GestorDispositivos(ReencolarProceso r, RegistroEventos *t = nullptr) : reencolar(std::move(r)), traza(t) {
+        agregar("disco", TipoDispositivo::DISCO);
+        agregar("red", TipoDispositivo::RED);
+        agregar("usb", TipoDispositivo::USB);
+    }
+
+    // Devuelve el handle del dispositivo nuevo, o -1 si el nombre ya existe
+    int agregar(const std::string &nombre, TipoDispositivo tipo) {
+        if (por_nombre.count(nombre)) return -1;
+        int d = (int)dispositivos.size();
+        dispositivos.emplace_back(nombre, tipo, traza, tiempo);
+        por_nombre[nombre] = d;
+        return d;
+    }
+
+    int buscar(const std::string &nombre) const {
+        auto it = por_nombre.find(nombre);
+        return it == por_nombre.end() ? -1 : it->second;
+    }
+
+    // Rechaza un dispositivo inexistente o un handle vacio (proceso que no existe)
+    bool solicitar(int d, HandleProceso p, int duracion, int prioridad) {
+        if (d < 0 || d >= (int)dispositivos.size() || !p) return false;
+        duracion = std::min(std::max(1, duracion), 1 << 30);
+        en_espera++;
+        if (dispositivos[d].solicitar({prioridad, p, duracion, tiempo, secuencia++}, tiempo)) iniciar(d);
+        return true;
+    }
+
+    void solicitar(const std::string& nombre, HandleProceso p, int duracion, int prioridad) {
+        int d = buscar(nombre);
+        if (d < 0) {
+            std::cout << "[!] Dispositivo '" << nombre << "' no existe\n";
+            return;
+        }
+        solicitar(d, p, duracion, prioridad);
+    }
+
+    void tick() {
+        tiempo++;
+        vencidos.clear();
+        rueda.avanzar(vencidos);
+        if (vencidos.size() > 1) std::sort(vencidos.begin(), vencidos.end()); // eventos en orden de handle
+        for (int d : vencidos) {
+            HandleProceso p = dispositivos[d].terminar(tiempo);
+            if (p && reencolar) reencolar(p);
+            en_espera--;
+            if (dispositivos[d].iniciar_siguiente(tiempo)) iniciar(d);
+        }
+    }
+
+    void avanzar(int ticks) {
+        for (int i = 0; i < ticks; ++i) tick();
+    }
+
+    int get_tiempo() const { return tiempo; }
+    size_t cantidad() const { return dispositivos.size(); }
+    size_t pendientes() const { return en_espera; }
+
+    // Tabla de dispositivos: todos si son pocos, si no los 'filas' de mayor utilizacion
+    void estado(size_t filas = 20) const;
+    void estado(const std::string &nombre) const;
+};
+
+
+// ------------------------- Impresora Simulada -------------------------
+// Spooler con reloj simulado propio (avanza con printproc, como iotick con los dispositivos).
+// Cuando esta libre toma de una vez hasta 'lote_max' trabajos de la cola y cobra COSTO_LOTE
+// ticks de preparacion por lote mas 1 tick cada CARACTERES_POR_TICK caracteres de cada trabajo.
+// Sacar el lote de la cola libera lugares: cada signal de sem_vacio despierta al primer proceso
+// bloqueado, cuyo trabajo pendiente entra a la cola en ese momento.
+class ImpresoraSimulada {
+public:
+    static constexpr int COSTO_LOTE = 2;
+    static constexpr int CARACTERES_POR_TICK = 16;
+    static constexpr size_t VENTANA_OCUPACION = 60; // ticks de la linea de tiempo de printstat
+
+    struct LatenciaPid {
+        int trabajos = 0;
+        long long total = 0; // ticks desde el pedido hasta el fin de la impresion
+        int max = 0;
+    };
+
+private:
+    struct Trabajo {
+        HandleProceso proceso;
+        std::string contenido;
+        int solicitado; // tick de la impresora en que se pidio (incluye el tiempo bloqueado)
+        int servicio;   // ticks de impresion
+    };
+
+    std::deque<Trabajo> cola_impresion;
+    std::deque<Trabajo> esperando_lugar; // de los procesos bloqueados en sem_vacio, en orden de llegada
+    std::deque<Trabajo> lote;            // en impresion; el frente es el trabajo actual
+    size_t capacidad;
+    size_t lote_max = 4;
+    int reloj = 0;
+    int restante = 0;               // ticks que le faltan al trabajo actual
+    SemaforoSimulado sem_vacio;  // capacidad disponible
+    SemaforoSimulado sem_ocupado; // trabajos en cola
+    mutable std::mutex mtx; // control de concurrencia simulada
+    ReencolarProceso reencolar; // devuelve al planificador a los procesos despertados
+    RegistroEventos *traza;
+
+    std::vector<long long> ticks_por_ocupacion; // ticks que la cola paso con k trabajos
+    std::deque<uint8_t> linea_ocupacion;        // ocupacion de los ultimos VENTANA_OCUPACION ticks
+    std::map<int, LatenciaPid> latencias;
+    long long lotes = 0, impresos = 0, ticks_ocupada = 0;
+
+    static int servicio_de(const std::string &contenido) { return 1 + (int)contenido.size() / CARACTERES_POR_TICK; }
+
+    // Con el mutex tomado
+    void encolar(Trabajo t) {
+        if (traza)
+            emitir(traza, NivelTraza::EVENTOS, TipoEvento::IMPRESION_ENVIO, reloj, reloj, t.proceso.pid,
+                   traza->texto(t.contenido));
+        cola_impresion.push_back(std::move(t));
+        sem_ocupado.signal();
+    }
+
+    // Con el mutex tomado: el lugar libre pasa al primer proceso bloqueado, si lo hay
+    void liberar_lugar() {
+        HandleProceso p = sem_vacio.signal();
+        if (!p) return;
+        emitir(traza, NivelTraza::EVENTOS, TipoEvento::IMPRESION_DESPERTAR, reloj, reloj, p.pid);
+        if (reencolar) reencolar(p);
+        // un sem_wait manual no deja trabajo pendiente: el lugar queda tomado por ese proceso
+        auto it = std::find_if(esperando_lugar.begin(), esperando_lugar.end(), [&](const Trabajo &t) {
+            return t.proceso.pid == p.pid && t.proceso.tabla == p.tabla;
+        });
+        if (it == esperando_lugar.end()) return;
+        Trabajo t = std::move(*it);
+        esperando_lugar.erase(it);
+        encolar(std::move(t));
+    }
+
+    // Con el mutex tomado: arma el siguiente lote con lo que haya en la cola
+    void tomar_lote() {
+        int total = COSTO_LOTE;
+        while (lote.size() < lote_max && !cola_impresion.empty() && sem_ocupado.try_wait()) {
+            lote.push_back(std::move(cola_impresion.front()));
+            cola_impresion.pop_front();
+            total += lote.back().servicio;
+            liberar_lugar();
+        }
+        if (lote.empty()) return;
+        lotes++;
+        emitir(traza, NivelTraza::EVENTOS, TipoEvento::IMPRESION_LOTE, reloj, reloj, 0, (int)lote.size(), total);
+        restante = COSTO_LOTE + lote.front().servicio;
+        iniciar_trabajo();
+    }
+
+    void iniciar_trabajo() {
+        const Trabajo &t = lote.front();
+        if (traza)
+            emitir(traza, NivelTraza::EVENTOS, TipoEvento::IMPRESION_INICIO, reloj, reloj, t.proceso.pid,
+                   traza->texto(t.contenido), t.servicio);
+    }
+
+    void anotar_ocupacion() {
+        size_t k = cola_impresion.size();
+        if (ticks_por_ocupacion.size() <= k) ticks_por_ocupacion.resize(k + 1, 0);
+        ticks_por_ocupacion[k]++;
+        linea_ocupacion.push_back((uint8_t)std::min<size_t>(k, 255));
+        if (linea_ocupacion.size() > VENTANA_OCUPACION) linea_ocupacion.pop_front();
+    }
+
+public:
+    ImpresoraSimulada(size_t cap = 3, RegistroEventos *t = nullptr)
+        : capacidad(cap), sem_vacio((int)cap), sem_ocupado(0), traza(t) {}
+
+    void set_reencolar(ReencolarProceso r) { reencolar = std::move(r); }
+    void set_lote(size_t n) {
+        std::lock_guard<std::mutex> lock(mtx);
+        lote_max = std::max<size_t>(1, n);
+    }
+    size_t get_lote() const { return lote_max; }
+
+    // Proceso solicita imprimir algo: si la cola esta llena queda BLOQUEADO en sem_vacio y su
+    // trabajo espera afuera hasta que se libere un lugar
+    bool producir_impresion(HandleProceso p, const std::string &contenido) {
+        std::lock_guard<std::mutex> lock(mtx);
+
+        if (p.estado() == EstadoProceso::BLOQUEADO) {
+            std::cout << "[!] El proceso " << p.pid << " esta bloqueado y no puede imprimir\n";
+            return false;
+        }
+        Trabajo t{p, contenido, reloj, servicio_de(contenido)};
+        if (sem_vacio.wait(p)) {
+            encolar(std::move(t));
+            return true;
+        }
+        esperando_lugar.push_back(std::move(t));
+        emitir(traza, NivelTraza::EVENTOS, TipoEvento::IMPRESION_BLOQUEO, reloj, reloj, p.pid);
+        return false;
+    }
+
+    // kill: el proceso deja de esperar lugar y su trabajo pendiente se descarta. Lo que ya
+    // entro a la cola se imprime igual, como en un spooler real.
+    void retirar_proceso(HandleProceso p) {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (!sem_vacio.retirar(p)) return;
+        auto it = std::find_if(esperando_lugar.begin(), esperando_lugar.end(), [&](const Trabajo &t) {
+            return t.proceso.pid == p.pid && t.proceso.tabla == p.tabla;
+        });
+        if (it != esperando_lugar.end()) esperando_lugar.erase(it);
+    }
+
+    // Un tick del reloj de la impresora; devuelve cuantos trabajos terminaron (0 o 1)
+    int tick() {
+        std::lock_guard<std::mutex> lock(mtx);
+        int terminados = 0;
+        if (lote.empty()) tomar_lote();
+        reloj++;
+        if (!lote.empty()) {
+            ticks_ocupada++;
+            if (--restante == 0) {
+                Trabajo &t = lote.front();
+                int latencia = reloj - t.solicitado;
+                LatenciaPid &l = latencias[t.proceso.pid];
+                l.trabajos++;
+                l.total += latencia;
+                l.max = std::max(l.max, latencia);
+                impresos++;
+                terminados = 1;
+                emitir(traza, NivelTraza::EVENTOS, TipoEvento::IMPRESION_FIN, reloj, reloj, t.proceso.pid, latencia);
+                lote.pop_front();
+                if (!lote.empty()) {
+                    restante = lote.front().servicio;
+                    iniciar_trabajo();
+                }
+            }
+        }
+        anotar_ocupacion();
+        return terminados;
+    }
+
+    // printproc: 'ticks' > 0 avanza ese tiempo; si no, hasta que termine el proximo trabajo.
+    // Con un lote en curso 'restante' baja en cada tick, asi que el trabajo termina; si tras un
+    // tick sigue sin lote es que la cola no se pudo tomar y esperar no cambiaria nada.
+    int procesar_impresion(int ticks = 0) {
+        if (ticks > 0) {
+            int n = 0;
+            for (int i = 0; i < ticks; ++i) n += tick();
+            return n;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (lote.empty() && cola_impresion.empty()) {
+                std::cout << "[IMPRESORA] No hay trabajos pendientes.\n";
+                return 0;
+            }
+        }
+        while (tick() == 0) {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (!lote.empty()) continue;
+            std::cout << "[!] La impresora no pudo tomar ninguno de los " << cola_impresion.size()
+                      << " trabajos en cola\n";
+            return 0;
+        }
+        return 1;
+    }
+
+    void estado() const;
+
+    // Solo lectura (semstat): la impresora es la unica que hace wait/signal sobre ellos
+    const SemaforoSimulado &semaforo_vacio() const { return sem_vacio; }
+    const SemaforoSimulado &semaforo_ocupado() const { return sem_ocupado; }
+};
+
+
+// ------------------------- Simulacion de planificacion de disco -------------------------
+class SimuladorDisco {
+private:
+    std::vector<int> solicitudes;
+    int posicion_inicial;
+    int movimiento_total;
+    RegistroEventos *traza;
+
+    void graficar_recorrido(const std::vector<int>& recorrido, const std::string& nombre_algoritmo) {
+        std::cout << "\n[GRAFICO] Recorrido del cabezal (" << nombre_algoritmo << ")\n";
+        std::cout << "Cilindros: ";
+        for (int c : recorrido) std::cout << c << " ";
+        std::cout << "\n\nEje aproximado (posicion del cabezal por orden de acceso):\n";
+
+        int min_c = *std::min_element(recorrido.begin(), recorrido.end());
+        int max_c = *std::max_element(recorrido.begin(), recorrido.end());
+        int rango = max_c - min_c + 1;
+
+        for (size_t i = 0; i < recorrido.size(); ++i) {
+            int offset = (int)((double)(recorrido[i] - min_c) / rango * 60); // ancho aproximado
+            std::cout << std::setw(2) << i+1 << " | " << std::string(offset, '-') << "*(" << recorrido[i] << ")\n";
+        }
+    }
+
+public:
+    // Recorridos sin salida (para ejecutar_* y los benchmarks); el primer elemento es la posicion inicial.
+    //
+    // SSTF: los cilindros ya atendidos forman siempre un intervalo contiguo del orden por cilindro
+    // alrededor del cabezal, asi que el mas cercano es el vecino libre de la izquierda o de la
+    // derecha: O(n log n) en lugar de buscar el minimo entre todos los pendientes en cada paso.
+    // Empates de distancia: gana la solicitud que llego primero, igual que el recorrido lineal.
+    static std::vector<int> recorrido_SSTF(const std::vector<int> &reqs, int pos) {
+        std::vector<int> orden(reqs.size());
+        for (size_t i = 0; i < orden.size(); ++i) orden[i] = (int)i;
+        std::sort(orden.begin(), orden.end(), [&](int a, int b) {
+            return reqs[a] != reqs[b] ? reqs[a] < reqs[b] : a < b;
+        });
+        // grupos de solicitudes al mismo cilindro: se atienden juntas (distancia 0 entre ellas)
+        std::vector<int> cilindro, primera, cantidad;
+        for (int i : orden) {
+            if (cilindro.empty() || cilindro.back() != reqs[i]) {
+                cilindro.push_back(reqs[i]);
+                primera.push_back(i);
+                cantidad.push_back(0);
+            }
+            cantidad.back()++;
+        }
+
+        std::vector<int> recorrido = {pos};
+        recorrido.reserve(reqs.size() + 1);
+        int der = (int)(std::lower_bound(cilindro.begin(), cilindro.end(), pos) - cilindro.begin());
+        int izq = der - 1;
+        while (izq >= 0 || der < (int)cilindro.size()) {
+            bool tomar_der;
+            if (izq < 0) tomar_der = true;
+            else if (der >= (int)cilindro.size()) tomar_der = false;
+            else {
+                int dd = cilindro[der] - pos, di = pos - cilindro[izq];
+                tomar_der = dd < di || (dd == di && primera[der] < primera[izq]);
+            }
+            int g = tomar_der ? der++ : izq--;
+            pos = cilindro[g];
+            recorrido.insert(recorrido.end(), cantidad[g], pos);
+        }
+        return recorrido;
+    }
+
+    static std::vector<int> recorrido_SCAN(const std::vector<int> &reqs, int pos, bool hacia_derecha = true,
+                                      int max_cilindro = 199) {
+        std::vector<int> menores, mayores;
+        for (int r : reqs) {
+            if (r < pos) menores.push_back(r);
+            else mayores.push_back(r);
+        }
+        std::sort(menores.begin(), menores.end());
+        std::sort(mayores.begin(), mayores.end());
+
+        std::vector<int> recorrido = {pos};
+        recorrido.reserve(reqs.size() + 2);
+
+        if (hacia_derecha) {
+            for (int r : mayores) recorrido.push_back(r);
+            recorrido.push_back(max_cilindro);
+            for (int i = (int)menores.size() - 1; i >= 0; --i) recorrido.push_back(menores[i]);
+        } else {
+            for (int i = (int)menores.size() - 1; i >= 0; --i) recorrido.push_back(menores[i]);
+            recorrido.push_back(0);
+            for (int r : mayores) recorrido.push_back(r);
+        }
+        return recorrido;
+    }
+
+    SimuladorDisco(std::vector<int> reqs, int pos_inicial, RegistroEventos *t = nullptr)
+        : solicitudes(reqs), posicion_inicial(pos_inicial), movimiento_total(0), traza(t) {}
+
+    void ejecutar_FCFS() {
+        std::cout << "\n[DISK] Algoritmo FCFS\n";
+        int pos = posicion_inicial;
+        movimiento_total = 0;
+        std::vector<int> recorrido = {pos};
+
+        for (int r : solicitudes) {
+            int movimiento = abs(r - pos);
+            emitir(traza, NivelTraza::EVENTOS, TipoEvento::DISCO_MOVIMIENTO, 0, 0, 0, pos, r, movimiento);
+            movimiento_total += movimiento;
+            pos = r;
+            recorrido.push_back(pos);
+        }
+        std::cout << "Movimiento total FCFS: " << movimiento_total << "\n";
+        graficar_recorrido(recorrido, "FCFS");
+    }
+
+    void ejecutar_SSTF() {
+        std::cout << "\n[DISK] Algoritmo SSTF\n";
+        std::vector<int> recorrido = recorrido_SSTF(solicitudes, posicion_inicial);
+        movimiento_total = 0;
+        for (size_t i = 1; i < recorrido.size(); ++i) {
+            int movimiento = abs(recorrido[i] - recorrido[i - 1]);
+            emitir(traza, NivelTraza::EVENTOS, TipoEvento::DISCO_MOVIMIENTO, 0, 0, 0, recorrido[i - 1], recorrido[i], movimiento);
+            movimiento_total += movimiento;
+        }
+        std::cout << "Movimiento total SSTF: " << movimiento_total << "\n";
+        graficar_recorrido(recorrido, "SSTF");
+    }
+
+    void ejecutar_SCAN(bool hacia_derecha = true, int max_cilindro = 199) {
+        std::cout << "\n[DISK] Algoritmo SCAN (" << (hacia_derecha ? "→ derecha" : "← izquierda") << ")\n";
+        std::vector<int> recorrido = recorrido_SCAN(solicitudes, posicion_inicial, hacia_derecha, max_cilindro);
+        movimiento_total = 0;
+
+        for (size_t i = 1; i < recorrido.size(); ++i) {
+            int mov = abs(recorrido[i] - recorrido[i - 1]);
+            emitir(traza, NivelTraza::EVENTOS, TipoEvento::DISCO_MOVIMIENTO, 0, 0, 0, recorrido[i - 1], recorrido[i], mov);
+            movimiento_total += mov;
+        }
+
+        std::cout << "Movimiento total SCAN: " << movimiento_total << "\n";
+        graficar_recorrido(recorrido, "SCAN");
+    }
+
+    void visualizar_linea_disco(int max_cilindro = 199, int ancho = 80) {
+        std::cout << "\n[Visualizacion Disco - Linea de Cilindros]\n";
+
+        int pos = posicion_inicial;
+        std::vector<char> linea(ancho, '-');
+
+        // Mapea los cilindros solicitados en la linea
+        for (int r : solicitudes) {
+            int idx = (r * ancho) / max_cilindro;
+            if (idx >= 0 && idx < ancho) linea[idx] = '|';
+        }
+
+        // Marca el cabezal
+        int pos_idx = (pos * ancho) / max_cilindro;
+        if (pos_idx >= 0 && pos_idx < ancho) linea[pos_idx] = 'O';
+
+        // Render
+        for (char c : linea) std::cout << c;
+        std::cout << "\nPosicion cabezal: " << pos
+            << " | Solicitudes: " << solicitudes.size() << "\n";
+    }
+
+};
+
+
+// ------------------------- Archivo mapeado en memoria -------------------------
+// Solo lectura: el SO trae las paginas a demanda y no hay copia a buffers propios.
+class ArchivoMapeado {
+private:
+    const uint8_t *datos_;
+    size_t tam_;
+
+public:
+    ArchivoMapeado() : datos_(nullptr), tam_(0) {}
+    ArchivoMapeado(const ArchivoMapeado &) = delete;
+    ArchivoMapeado &operator=(const ArchivoMapeado &) = delete;
+    ~ArchivoMapeado() { cerrar(); }
+
+    bool abrir(const std::string &ruta) {
+        cerrar();
+        int fd = open(ruta.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) { close(fd); return false; }
+        void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (p == MAP_FAILED) return false;
+        madvise(p, st.st_size, MADV_SEQUENTIAL);
+        datos_ = (const uint8_t *)p;
+        tam_ = st.st_size;
+        return true;
+    }
+
+    void cerrar() {
+        if (datos_) munmap((void *)datos_, tam_);
+        datos_ = nullptr;
+        tam_ = 0;
+    }
+
+    const uint8_t *datos() const { return datos_; }
+    size_t tam() const { return tam_; }
+};
+
+
+// ------------------------- Cargas de trabajo binarias -------------------------
+// Formato columnar: cabecera y luego cada campo como arreglo contiguo, para que el
+// cargador use los punteros del mapeo directamente.
+//   uint32 tiempo[n], uint32 llegada[n]                     (llegada relativa a la carga)
+//   uint32 acceso_pid[a], uint32 acceso_pagina[a]           (pid 1..n dentro de la carga)
+//   uint32 io_pid[e], uint32 io_duracion[e], uint8 io_dispositivo[e], uint8 io_prioridad[e]
+struct CabeceraCarga {
+    char magia[4];          // "SOWL"
+    uint32_t version;
+    uint64_t semilla;
+    uint64_t n_procesos;
+    uint64_t n_accesos;
+    uint64_t n_io;
+};
+
+inline const char *const DISPOSITIVOS_CARGA[] = {"disco", "red", "usb"};
+
+
+// Vista sobre un archivo de carga mapeado; los punteros valen mientras viva el ArchivoMapeado
+struct VistaCarga {
+    const CabeceraCarga *cab = nullptr;
+    const uint32_t *tiempo = nullptr, *llegada = nullptr;
+    const uint32_t *acceso_pid = nullptr, *acceso_pagina = nullptr;
+    const uint32_t *io_pid = nullptr, *io_duracion = nullptr;
+    const uint8_t *io_dispositivo = nullptr, *io_prioridad = nullptr;
+
+    bool abrir(const ArchivoMapeado &m) {
+        if (m.tam() < sizeof(CabeceraCarga)) return false;
+        cab = (const CabeceraCarga *)m.datos();
+        if (memcmp(cab->magia, "SOWL", 4) != 0 || cab->version != 1) return false;
+        uint64_t n = cab->n_procesos, a = cab->n_accesos, e = cab->n_io;
+        // los conteos vienen del archivo: se comparan contra lo que queda dividiendo, sin desbordar
+        uint64_t resto = m.tam() - sizeof(CabeceraCarga);
+        if (n > INT_MAX || n > resto / 8) return false;
+        resto -= 8 * n;
+        if (a > resto / 8) return false;
+        resto -= 8 * a;
+        if (e > resto / 10 || resto != 10 * e) return false;
+        const uint32_t *p = (const uint32_t *)(m.datos() + sizeof(CabeceraCarga));
+        tiempo = p;           p += n;
+        llegada = p;          p += n;
+        acceso_pid = p;       p += a;
+        acceso_pagina = p;    p += a;
+        io_pid = p;           p += e;
+        io_duracion = p;      p += e;
+        io_dispositivo = (const uint8_t *)p;
+        io_prioridad = io_dispositivo + e;
+        // los pid de accesos y E/S se traducen a PIDs del planificador (load, sweep): 1..n
+        for (uint64_t i = 0; i < a; ++i)
+            if (acceso_pid[i] < 1 || acceso_pid[i] > n) return false;
+        for (uint64_t i = 0; i < e; ++i)
+            if (io_pid[i] < 1 || io_pid[i] > n) return false;
+        return true;
+    }
+};
+
+
+enum class DistribucionRafaga { EXPONENCIAL, PARETO, BIMODAL };
+
+struct ParametrosCarga {
+    uint64_t n = 1000;
+    uint64_t semilla = 1;
+    double llegada_media = 0;     // media entre llegadas (Poisson); 0 = todos en t=0
+    DistribucionRafaga rafaga = DistribucionRafaga::EXPONENCIAL;
+    double rafaga_media = 10;
+    int paginas = 0;              // referencias a pagina por proceso
+    int rango_paginas = 16;       // paginas distintas por proceso
+    int io = 0;                   // solicitudes de E/S por proceso
+};
+
+
+// Genera la carga con una semilla fija (mismo archivo para los mismos parametros) y la escribe.
+// Rafagas: exponencial; Pareto (alfa=1.5, misma media, cola pesada); bimodal (80% cortas de
+// media/4, 20% largas de 4*media). Las paginas siguen un 80/20: el 80% de las referencias
+// cae en el 20% de las paginas del proceso.
+bool generar_carga(const std::string &ruta, const ParametrosCarga &par);
+
+
+// ------------------------- Barrido de parametros (sweep) -------------------------
+// Una carga de trabajo (procesos + accesos a memoria) que se repite en cada configuracion.
+struct CargaTrabajo {
+    struct Proceso { int tiempo; int llegada; }; // llegada absoluta
+    std::vector<Proceso> procesos;
+    std::vector<std::pair<int,int>> accesos;               // (pid, pagina) en orden
+
+    // Agrega una carga binaria (gen) empezando en 'base'; los pid de los accesos se desplazan
+    // para coincidir con los PIDs asignados a partir de 'primer_pid'.
+    void agregar(const VistaCarga &v, int base, int primer_pid) {
+        size_t n = v.cab->n_procesos, a = v.cab->n_accesos;
+        procesos.reserve(procesos.size() + n);
+        for (size_t i = 0; i < n; ++i) procesos.push_back({(int)v.tiempo[i], base + (int)v.llegada[i]});
+        accesos.reserve(accesos.size() + a);
+        for (size_t i = 0; i < a; ++i) accesos.push_back({primer_pid - 1 + (int)v.acceso_pid[i], (int)v.acceso_pagina[i]});
+    }
+
+    // Acepta una carga binaria (gen) o texto: las mismas lineas de la consola,
+    // "new <tiempo> [llegada]" y "mem <pid> <pag>". En texto se ignoran lineas vacias,
+    // comentarios (#) y otros comandos.
+    bool cargar(const std::string &ruta) {
+        ArchivoMapeado m;
+        VistaCarga v;
+        if (m.abrir(ruta) && v.abrir(m)) {
+            procesos.clear();
+            accesos.clear();
+            agregar(v, 0, 1);
+            return true;
+        }
+        return cargar_texto(ruta);
+    }
+
+    bool cargar_texto(const std::string &ruta) {
+        std::ifstream in(ruta);
+        if (!in) return false;
+        procesos.clear();
+        accesos.clear();
+        std::string linea;
+        while (std::getline(in, linea)) {
+            std::stringstream ss(linea);
+            std::string cmd; ss >> cmd;
+            if (cmd == "new") {
+                int t, llegada = 0;
+                if (!(ss >> t)) continue;
+                if (!(ss >> llegada)) llegada = 0;
+                procesos.push_back({t, llegada});
+            } else if (cmd == "mem") {
+                int pid, pag;
+                if (ss >> pid >> pag && pid >= 0) accesos.push_back({pid, pag});
+            }
+        }
+        return true;
+    }
+};
+
+
+// Pool de hilos minimo: cada hilo toma la siguiente tarea libre de un contador atomico.
+// Las tareas son independientes, asi que no hay mas sincronizacion que ese contador.
+class PoolHilos {
+private:
+    int n_hilos;
+
+public:
+    explicit PoolHilos(int n = 0) {
+        n_hilos = n > 0 ? n : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    int hilos() const { return n_hilos; }
+
+    void ejecutar(int n_tareas, const std::function<void(int)> &tarea) {
+        std::atomic<int> siguiente{0};
+        auto trabajador = [&]() {
+            for (int i = siguiente++; i < n_tareas; i = siguiente++) tarea(i);
+        };
+        std::vector<std::thread> hilos;
+        int n = std::min(n_hilos, n_tareas);
+        for (int h = 1; h < n; ++h) hilos.emplace_back(trabajador);
+        trabajador();
+        for (auto &h : hilos) h.join();
+    }
+};
+
+
+// Planificacion: quantum qmin..qmax en RR, mas SJF y CFS (no dependen del quantum, una fila cada uno).
+// Cada configuracion es una simulacion independiente sin traza.
+void barrido_cpu(const CargaTrabajo &carga, int qmin, int qmax, int ncpus, PoolHilos &pool);
+
+
+// Memoria: marcos mmin..mmax x {FIFO, LRU, WS, CLOCK, SC, AGING} sobre la misma secuencia de accesos.
+void barrido_memoria(const CargaTrabajo &carga, int mmin, int mmax, int ventana, PoolHilos &pool);
+
+
+// TLB vs quantum: RR en una CPU con quantum qmin..qmax; en cada tick el proceso en CPU hace su
+// siguiente acceso de la carga (en ciclo). Cada quantum se corre vaciando el TLB y con ASID.
+void barrido_tlb(const CargaTrabajo &carga, int qmin, int qmax, const ConfigTLB &tlb, int marcos, PoolHilos &pool);
+
+
+// ------------------------- Curvas de fallos (Mattson) -------------------------
+// LRU y OPT son algoritmos de pila: el contenido con m marcos esta incluido en el de m+1.
+// Una sola pasada calcula la distancia de pila de cada acceso (paginas distintas tocadas
+// desde su uso anterior) y de su histograma salen los fallos LRU para todo m = 1..N.
+// OPT (Belady, opcional) se simula fuera de linea con los indices de proximo uso: una
+// pasada O(n log n) por cada tamano de la tabla, repartidas en el pool de hilos.
+struct CurvaFallos {
+    long long accesos = 0;
+    int paginas_distintas = 0;       // fallos frios: ningun tamano los evita
+    std::vector<long long> fallos_lru;    // indice = marcos (0..max_marcos)
+    std::vector<int> marcos_tabla;        // tamanos que se muestran (y en los que se simula OPT)
+    std::vector<long long> fallos_opt;    // paralelo a marcos_tabla (vacio sin OPT)
+    double ms_lru = 0, ms_opt = 0;
+};
+
+// 'referencias' son claves (pid << 32 | pagina), p.ej. de GestorMarcos::referencias_registradas
+CurvaFallos calcular_curva_fallos(const std::vector<uint64_t> &referencias, int max_marcos, bool con_opt, PoolHilos &pool);
+
+void imprimir_curva_fallos(const CurvaFallos &c);
+
+
+// ------------------------- Reproduccion de trazas de memoria -------------------------
+// memload acepta texto ("[mem] <pid> <pag> [r|w]" por linea, # comentarios), una carga
+// binaria de gen (solo lecturas) o la traza columnar de 'memtrace archivo'. El archivo se
+// mapea, se decodifica por lotes y cada lote va a GestorMarcos::acceder_lote.
+struct ResumenReproduccion {
+    const char *formato = "";
+    uint64_t accesos = 0;
+    uint64_t ignorados = 0; // lineas invalidas o pids fuera de rango
+    long long ticks = 0;    // tiempo simulado de los accesos
+};
+
+bool reproducir_traza_memoria(const std::string &ruta, GestorMarcos &gestor, ResumenReproduccion &r);